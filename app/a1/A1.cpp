@@ -64,7 +64,7 @@ struct Player final : Entity<2> {
         }
     }
 
-    Status tick(const List<Message> &messages) override {
+    Status tick(const Messages messages) override {
         const auto bbox = this->bbox();
         Box<2> dig_box{bbox.min - 10, {bbox.end[0] + 10, bbox.end[1]}};
         if (digging) {
@@ -27,7 +27,7 @@ void Player::draw(Window *, const Color &) const {
     // }
 }
 
-Status Player::tick(const List<Message> &messages) { return Entity::tick(messages); }
+Status Player::tick(const Messages messages) { return Entity::tick(messages); }
 
 Status Player::broken(const List<Set<Rel<Part>>> &) { return Status::kNone; }
 
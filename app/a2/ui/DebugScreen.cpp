@@ -46,6 +46,7 @@ void DebugScreen::draw() {
     const Vec<3> look = view3d.project() / view3d.scale;
     const std::string target = get_target(world_);
     const Player *player(world_->player);
+    const auto parts = world_->part_stats();
 
     // clang-format off
     List<std::string> messages{
@@ -58,7 +59,10 @@ void DebugScreen::draw() {
         "Target: " + target,
         "Angle:  " + std::to_string(view3d.angle),
         "Pitch:  " + std::to_string(view3d.pitch),
-        "Alive: " + std::to_string(world_->num_awake()) + "/" + std::to_string(world_->num_alive())
+        "Alive: " + std::to_string(world_->num_awake()) + "/" + std::to_string(world_->num_alive()),
+        "Msgs:  " + std::to_string(world_->messages_last()) + " (max " + std::to_string(world_->messages_max()) + ")",
+        "Fanout: " + std::to_string(world_->fanout_last()) + " (max " + std::to_string(world_->fanout_max()) + ")",
+        "Parts: " + std::to_string(parts.parts) + " (max " + std::to_string(parts.max) + " per entity)"
     };
     // clang-format on
 
@@ -1,5 +1,7 @@
 #include "a2/world/WorldA2.h"
 
+#include <thread>
+
 #include "a2/entity/Player.h"
 #include "a2/macros/Literals.h"
 #include "a2/ui/DeathScreen.h"
@@ -26,7 +28,8 @@ WorldA2::WorldA2(AbstractScreen *parent)
                         .maximum_y = 10_m,
                         .ms_per_tick = a2::kMillisPerTick,
                         .pixels_per_meter = a2::kPixelsPerMeter,
-                        .terminal_velocity = 53_mps}) {
+                        .terminal_velocity = 53_mps,
+                        .tick_threads = static_cast<I64>(std::thread::hardware_concurrency())}) {
 
     window_->set_background(Color::kSkyBlue);
     open<PauseScreen>(this);
@@ -6,6 +6,7 @@
 #include "nvl/macros/Abstract.h"
 #include "nvl/macros/Aliases.h"
 #include "nvl/macros/Pure.h"
+#include "nvl/message/Message.h"
 #include "nvl/reflect/CastablePtr.h"
 #include "nvl/ui/Color.h"
 
@@ -13,11 +14,10 @@ namespace nvl {
 
 struct Actor;
 class Window;
-struct Message;
 
 abstract struct AbstractActor : CastablePtr<Actor, AbstractActor>::BaseClass {
     class_tag(AbstractActor);
-    virtual Status tick(const List<Message> &messages) = 0;
+    virtual Status tick(Messages messages) = 0;
     virtual void draw(Window *window, const Color &scale) const = 0;
 };
 
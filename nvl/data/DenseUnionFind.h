@@ -0,0 +1,119 @@
+#pragma once
+
+#include <numeric>
+#include <span>
+
+#include "nvl/data/List.h"
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Pure.h"
+#include "nvl/macros/ReturnIf.h"
+
+namespace nvl {
+
+/**
+ * @class DenseUnionFind
+ * @brief Union-find over the contiguous ids [0, size), backed by flat vectors.
+ *
+ * Groups are materialized lazily: the ids in each group are laid out contiguously in one list, and each group is
+ * returned as a span into it. The spans are invalidated by any subsequent add or merge.
+ */
+class DenseUnionFind {
+public:
+    DenseUnionFind() = default;
+    explicit DenseUnionFind(const U64 size) : parent_(size), rank_(size, 0), num_sets_(size) {
+        std::iota(parent_.begin(), parent_.end(), 0);
+    }
+
+    /// Adds a new id in its own set and returns it.
+    U64 add() {
+        const U64 id = parent_.size();
+        parent_.push_back(id);
+        rank_.push_back(0);
+        ++num_sets_;
+        changed_ = true;
+        return id;
+    }
+
+    /// Returns the representative id for the set containing [id].
+    pure U64 find(const U64 id) const {
+        U64 root = id;
+        while (parent_[root] != root) {
+            root = parent_[root];
+        }
+        // Full path compression - point every id on the path directly at the root
+        for (U64 v = id; parent_[v] != root;) {
+            const U64 next = parent_[v];
+            parent_[v] = root;
+            v = next;
+        }
+        return root;
+    }
+
+    /// Combines the sets containing [a] and [b]. Returns true if they were previously separate.
+    bool merge(const U64 a, const U64 b) {
+        U64 root_a = find(a);
+        U64 root_b = find(b);
+        return_if(root_a == root_b, false);
+        // Union by rank
+        if (rank_[root_a] < rank_[root_b]) {
+            std::swap(root_a, root_b);
+        }
+        parent_[root_b] = root_a;
+        if (rank_[root_a] == rank_[root_b]) {
+            ++rank_[root_a];
+        }
+        --num_sets_;
+        changed_ = true;
+        return true;
+    }
+
+    /// Returns true if [a] and [b] are in the same set.
+    pure bool same(const U64 a, const U64 b) const { return find(a) == find(b); }
+
+    /// Returns the number of ids.
+    pure U64 size() const { return parent_.size(); }
+
+    /// Returns the current number of disjoint sets.
+    pure U64 num_sets() const { return num_sets_; }
+
+    /// Returns the ids in each disjoint set.
+    pure const List<std::span<const U64>> &sets() const {
+        update_groups();
+        return groups_;
+    }
+
+private:
+    /// Lays out ids grouped by their root with a counting sort, then records the span of each group.
+    void update_groups() const {
+        return_if(!changed_);
+        changed_ = false;
+        const U64 n = parent_.size();
+        List<U64> offsets(n + 1, 0);
+        for (U64 id = 0; id < n; ++id) {
+            ++offsets[find(id) + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        List<U64> next(offsets.begin(), offsets.end() - 1);
+        members_.resize(n);
+        for (U64 id = 0; id < n; ++id) {
+            members_[next[parent_[id]]++] = id; // parent_ is the root after find() above
+        }
+        groups_.clear();
+        groups_.reserve(num_sets_);
+        for (U64 root = 0; root < n; ++root) {
+            if (parent_[root] == root) {
+                groups_.emplace_back(members_.begin() + offsets[root], offsets[root + 1] - offsets[root]);
+            }
+        }
+    }
+
+    mutable List<U64> parent_;
+    List<U64> rank_;
+    U64 num_sets_ = 0;
+
+    mutable bool changed_ = true;
+    mutable List<U64> members_;
+    mutable List<std::span<const U64>> groups_;
+};
+
+} // namespace nvl
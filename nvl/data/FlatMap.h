@@ -0,0 +1,255 @@
+#pragma once
+
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include "nvl/data/FlatTable.h"
+#include "nvl/data/Iterator.h"
+#include "nvl/data/Range.h"
+#include "nvl/macros/Assert.h"
+#include "nvl/macros/Pure.h"
+
+namespace nvl {
+
+/**
+ * @class FlatMap
+ * @brief An unordered map from keys to values, stored in a flat open addressing table.
+ *
+ * Provides the same interface as Map, but without allocating per entry. Unlike Map, references to keys and values
+ * are only valid until the next insertion or removal. Prefer Map when stable references are required.
+ *
+ * @tparam K - The key type.
+ * @tparam V - The value type.
+ * @tparam Hash - The hasher for type K. Defaults to std::hash.
+ * @tparam Equal - The equality check for type K. Defaults to std::equal_to, which uses operator==.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename Equal = std::equal_to<K>>
+class FlatMap {
+public:
+    using Entry = std::pair<const K, V>;
+
+private:
+    struct KeyOf {
+        pure const K &operator()(const Entry &entry) const { return entry.first; }
+    };
+    using Table = detail::FlatTable<K, Entry, KeyOf, Hash, Equal>;
+
+public:
+    using iterator = detail::FlatIterator<Table, Entry>;
+    using const_iterator = detail::FlatIterator<const Table, const Entry>;
+
+    /**
+     * @struct entry_iterator
+     * @brief An iterator over a map's (key, value) pairs.
+     */
+    struct entry_iterator final : AbstractIteratorCRTP<entry_iterator, Entry> {
+        class_tag(FlatMap::entry_iterator, AbstractIterator<Entry>);
+        template <View Type = View::kImmutable>
+        static Iterator<Entry, Type> begin(const FlatMap &map) {
+            return make_iterator<entry_iterator, Type>(&map.table_, map.table_.next(0));
+        }
+        template <View Type = View::kImmutable>
+        static Iterator<Entry, Type> end(const FlatMap &map) {
+            return make_iterator<entry_iterator, Type>(&map.table_, map.table_.capacity());
+        }
+
+        explicit entry_iterator(const Table *table, const U64 index) : table(table), index(index) {}
+
+        void increment() override { index = table->next(index + 1); }
+        const Entry *ptr() override { return &(*table)[index]; }
+
+        pure bool operator==(const entry_iterator &rhs) const override { return index == rhs.index; }
+
+        const Table *table;
+        U64 index;
+    };
+
+    /**
+     * @struct value_iterator
+     * @brief An iterator over a map's values.
+     */
+    struct value_iterator final : AbstractIteratorCRTP<value_iterator, V> {
+        class_tag(FlatMap::value_iterator, AbstractIterator<V>);
+        template <View Type = View::kImmutable>
+        static Iterator<V, Type> begin(const FlatMap &map) {
+            return make_iterator<value_iterator, Type>(&map.table_, map.table_.next(0));
+        }
+        template <View Type = View::kImmutable>
+        static Iterator<V, Type> end(const FlatMap &map) {
+            return make_iterator<value_iterator, Type>(&map.table_, map.table_.capacity());
+        }
+
+        explicit value_iterator(const Table *table, const U64 index) : table(table), index(index) {}
+
+        void increment() override { index = table->next(index + 1); }
+        const V *ptr() override { return &(*table)[index].second; }
+
+        pure bool operator==(const value_iterator &rhs) const override { return index == rhs.index; }
+
+        const Table *table;
+        U64 index;
+    };
+
+    /**
+     * @struct key_iterator
+     * @brief An iterator over a map's keys.
+     */
+    struct key_iterator final : AbstractIteratorCRTP<key_iterator, K> {
+        class_tag(FlatMap::key_iterator, AbstractIterator<K>);
+        template <View Type = View::kImmutable>
+        static Iterator<K, Type> begin(const FlatMap &map) {
+            return make_iterator<key_iterator, Type>(&map.table_, map.table_.next(0));
+        }
+        template <View Type = View::kImmutable>
+        static Iterator<K, Type> end(const FlatMap &map) {
+            return make_iterator<key_iterator, Type>(&map.table_, map.table_.capacity());
+        }
+
+        explicit key_iterator(const Table *table, const U64 index) : table(table), index(index) {}
+
+        void increment() override { index = table->next(index + 1); }
+        const K *ptr() override { return &(*table)[index].first; }
+
+        pure bool operator==(const key_iterator &rhs) const override { return index == rhs.index; }
+
+        const Table *table;
+        U64 index;
+    };
+
+    FlatMap() = default;
+    FlatMap(std::initializer_list<Entry> init) {
+        table_.reserve(init.size());
+        for (const Entry &entry : init) {
+            table_.try_emplace(entry.first, entry);
+        }
+    }
+
+    pure U64 size() const { return table_.size(); }
+    pure bool empty() const { return table_.empty(); }
+    void clear() { table_.clear(); }
+    void reserve(const U64 count) { table_.reserve(count); }
+
+    V &operator[](const K &key) { return emplace(key); }
+
+    pure V &at(const K &key) {
+        const U64 index = table_.find(key);
+        ASSERT(index != Table::kNone, "Key not found in map.");
+        return table_[index].second;
+    }
+    pure const V &at(const K &key) const { return const_cast<FlatMap *>(this)->at(key); }
+
+    /// Constructs the value for [key] from [args] if [key] is not present. Returns the value for [key].
+    template <typename... Args>
+    V &emplace(const K &key, Args &&...args) {
+        const auto [index, _] = table_.try_emplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                                   std::forward_as_tuple(std::forward<Args>(args)...));
+        return table_[index].second;
+    }
+
+    FlatMap &erase(const const_iterator iter) {
+        table_.erase(iter.index());
+        return *this;
+    }
+
+    FlatMap &erase(const K &key) {
+        remove(key);
+        return *this;
+    }
+
+    pure const_iterator find(const K &key) const {
+        const U64 index = table_.find(key);
+        return {&table_, index == Table::kNone ? table_.capacity() : index};
+    }
+    pure iterator find(const K &key) {
+        const U64 index = table_.find(key);
+        return {&table_, index == Table::kNone ? table_.capacity() : index};
+    }
+
+    pure V *get(const K &key) const {
+        const U64 index = table_.find(key);
+        return index == Table::kNone ? nullptr : const_cast<V *>(&table_[index].second);
+    }
+
+    pure const V &get_or(const K &key, const V &v) const {
+        const U64 index = table_.find(key);
+        return index == Table::kNone ? v : table_[index].second;
+    }
+
+    V &get_or_add(const K &key, V v) { return emplace(key, std::move(v)); }
+
+    V &get_or_lazily_add(const K &key, const std::function<V()> &func) {
+        if (const U64 index = table_.find(key); index != Table::kNone) {
+            return table_[index].second;
+        }
+        return emplace(key, func());
+    }
+
+    void remove(const K &key) {
+        if (const U64 index = table_.find(key); index != Table::kNone) {
+            table_.erase(index);
+        }
+    }
+    void remove(const Range<K> &keys) {
+        for (const K &key : keys) {
+            remove(key);
+        }
+    }
+
+    pure bool has(const K &key) const { return table_.find(key) != Table::kNone; }
+
+    pure bool operator==(const FlatMap &other) const {
+        return_if(size() != other.size(), false);
+        for (U64 i = table_.next(0); i < table_.capacity(); i = table_.next(i + 1)) {
+            const V *value = other.get(table_[i].first);
+            return_if(value == nullptr || !(*value == table_[i].second), false);
+        }
+        return true;
+    }
+    pure bool operator!=(const FlatMap &other) const { return !(*this == other); }
+
+    pure MRange<Entry> entries() {
+        return {entry_iterator::template begin<View::kMutable>(*this),
+                entry_iterator::template end<View::kMutable>(*this)};
+    }
+    pure Range<Entry> entries() const { return {entry_iterator::begin(*this), entry_iterator::end(*this)}; }
+
+    // Iteration over the map itself uses concrete iterators, which do not allocate.
+    // Use entries(), values(), or keys() to pass the map as a type-erased Range.
+    pure iterator begin() { return {&table_, table_.next(0)}; }
+    pure iterator end() { return {&table_, table_.capacity()}; }
+    pure const_iterator begin() const { return {&table_, table_.next(0)}; }
+    pure const_iterator end() const { return {&table_, table_.capacity()}; }
+
+    pure MRange<V> values() { return {values_begin(), values_end()}; }
+    pure Range<V> values() const { return {values_begin(), values_end()}; }
+
+    pure MIterator<V> values_begin() { return value_iterator::template begin<View::kMutable>(*this); }
+    pure MIterator<V> values_end() { return value_iterator::template end<View::kMutable>(*this); }
+    pure Iterator<V> values_begin() const { return value_iterator::template begin<View::kImmutable>(*this); }
+    pure Iterator<V> values_end() const { return value_iterator::template end<View::kImmutable>(*this); }
+
+    pure Range<K> keys() const { return {keys_begin(), keys_end()}; }
+    pure Iterator<K> keys_begin() const { return key_iterator::template begin<View::kImmutable>(*this); }
+    pure Iterator<K> keys_end() const { return key_iterator::template end<View::kImmutable>(*this); }
+
+private:
+    Table table_;
+};
+
+template <typename K, typename V, typename Hash, typename Equal>
+std::ostream &operator<<(std::ostream &os, const FlatMap<K, V, Hash, Equal> &map) {
+    os << "{";
+    auto once = map.entries().once();
+    if (!once.empty()) {
+        os << once->first << ": " << once->second;
+        ++once;
+    }
+    while (once.has_next()) {
+        os << ", " << once->first << ": " << once->second;
+        ++once;
+    }
+    return os << "}";
+}
+
+} // namespace nvl
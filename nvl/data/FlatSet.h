@@ -0,0 +1,139 @@
+#pragma once
+
+#include <functional>
+
+#include "nvl/data/FlatTable.h"
+#include "nvl/data/Iterator.h"
+#include "nvl/data/Range.h"
+#include "nvl/macros/Pure.h"
+#include "nvl/macros/ReturnIf.h"
+
+namespace nvl {
+
+/**
+ * @class FlatSet
+ * @brief An unordered set of values, stored in a flat open addressing table.
+ *
+ * Provides the same interface as Set, but without allocating per value. Unlike Set, references to values are only
+ * valid until the next insertion or removal.
+ *
+ * @tparam Value - The value type.
+ * @tparam Hash - The hasher for type Value. Defaults to std::hash.
+ */
+template <typename Value, typename Hash = std::hash<Value>>
+class FlatSet {
+    struct KeyOf {
+        pure const Value &operator()(const Value &value) const { return value; }
+    };
+    using Table = detail::FlatTable<Value, Value, KeyOf, Hash, std::equal_to<Value>>;
+
+public:
+    using value_type = Value;
+    using const_iterator = detail::FlatIterator<const Table, const Value>;
+
+    struct iterator final : AbstractIteratorCRTP<iterator, Value> {
+        class_tag(FlatSet::iterator, AbstractIterator<Value>);
+        template <View Type = View::kImmutable>
+        static Iterator<Value, Type> begin(const FlatSet &set) {
+            return make_iterator<iterator, Type>(&set.table_, set.table_.next(0));
+        }
+        template <View Type = View::kImmutable>
+        static Iterator<Value, Type> end(const FlatSet &set) {
+            return make_iterator<iterator, Type>(&set.table_, set.table_.capacity());
+        }
+        explicit iterator(const Table *table, const U64 index) : table(table), index(index) {}
+        void increment() override { index = table->next(index + 1); }
+        pure const Value *ptr() override { return &(*table)[index]; }
+        pure bool operator==(const iterator &rhs) const override { return index == rhs.index; }
+
+        const Table *table;
+        U64 index;
+    };
+
+    FlatSet() = default;
+    FlatSet(std::initializer_list<Value> init) {
+        for (const Value &value : init) {
+            insert(value);
+        }
+    }
+    explicit FlatSet(const Range<Value> &range) { insert(range); }
+
+    pure U64 size() const { return table_.size(); }
+    pure bool empty() const { return table_.empty(); }
+    void clear() { table_.clear(); }
+    void reserve(const U64 count) { table_.reserve(count); }
+
+    /// Inserts [value] if it is not present. Returns true if it was inserted.
+    bool insert(const Value &value) { return table_.try_emplace(value, value).second; }
+
+    template <typename... Args>
+    bool emplace(Args &&...args) {
+        const Value value(std::forward<Args>(args)...);
+        return table_.try_emplace(value, value).second;
+    }
+
+    FlatSet &insert(const FlatSet &rhs) {
+        reserve(size() + rhs.size());
+        for (U64 i = rhs.table_.next(0); i < rhs.table_.capacity(); i = rhs.table_.next(i + 1)) {
+            insert(rhs.table_[i]);
+        }
+        return *this;
+    }
+
+    FlatSet &insert(const Range<Value> &range) {
+        for (const Value &value : range) {
+            insert(value);
+        }
+        return *this;
+    }
+
+    FlatSet &remove(const Value &value) {
+        if (const U64 index = table_.find(value); index != Table::kNone) {
+            table_.erase(index);
+        }
+        return *this;
+    }
+
+    FlatSet &remove(const Range<Value> &range) {
+        for (const Value &value : range) {
+            remove(value);
+        }
+        return *this;
+    }
+
+    pure const_iterator find(const Value &value) const {
+        const U64 index = table_.find(value);
+        return {&table_, index == Table::kNone ? table_.capacity() : index};
+    }
+
+    pure bool has(const Value &value) const { return table_.find(value) != Table::kNone; }
+
+    // Iteration over the set itself uses concrete iterators, which do not allocate.
+    // Use values() to pass the set as a type-erased Range.
+    pure const_iterator begin() const { return {&table_, table_.next(0)}; }
+    pure const_iterator end() const { return {&table_, table_.capacity()}; }
+
+    pure MRange<Value> values() {
+        return {iterator::template begin<View::kMutable>(*this), iterator::template end<View::kMutable>(*this)};
+    }
+    pure Range<Value> values() const { return {iterator::begin(*this), iterator::end(*this)}; }
+
+    pure bool operator==(const FlatSet &rhs) const {
+        return_if(size() != rhs.size(), false);
+        for (U64 i = table_.next(0); i < table_.capacity(); i = table_.next(i + 1)) {
+            return_if(!rhs.has(table_[i]), false);
+        }
+        return true;
+    }
+    pure bool operator!=(const FlatSet &rhs) const { return !(*this == rhs); }
+
+private:
+    Table table_;
+};
+
+template <typename Value, typename Hash>
+std::ostream &operator<<(std::ostream &os, const FlatSet<Value, Hash> &set) {
+    return os << set.values();
+}
+
+} // namespace nvl
@@ -0,0 +1,260 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Pure.h"
+#include "nvl/macros/ReturnIf.h"
+
+namespace nvl::detail {
+
+/**
+ * @class FlatTable
+ * @brief Open addressing hash table with linear probing, kept in Robin Hood order.
+ *
+ * Entries are stored inline in a single array, so inserting does not allocate unless the table grows, and lookups
+ * scan contiguous memory. Each slot records its distance from the slot its key hashes to. Entries within a run of
+ * occupied slots are kept sorted by that home slot, so lookups can stop as soon as they pass where the key would be.
+ * Removal shifts the rest of the run back by one slot instead of leaving tombstones.
+ *
+ * Unlike node-based tables, references to entries are invalidated by any insertion or removal.
+ *
+ * @tparam Key - Key type.
+ * @tparam Entry - Type stored in each slot.
+ * @tparam KeyOf - Function object returning the key of an entry.
+ * @tparam Hash - The hasher for type Key.
+ * @tparam Equal - The equality check for type Key.
+ */
+template <typename Key, typename Entry, typename KeyOf, typename Hash, typename Equal>
+class FlatTable {
+public:
+    static constexpr U64 kNone = std::numeric_limits<U64>::max();
+    static constexpr U64 kMinCapacity = 8;
+
+    FlatTable() = default;
+    FlatTable(const FlatTable &rhs)
+        requires std::is_copy_constructible_v<Entry>
+    {
+        reserve(rhs.size_);
+        for (U64 i = rhs.next(0); i < rhs.capacity_; i = rhs.next(i + 1)) {
+            construct(place(key_of(rhs.entries_[i])), rhs.entries_[i]);
+        }
+    }
+    FlatTable(FlatTable &&rhs) noexcept { swap(rhs); }
+    ~FlatTable() { deallocate(); }
+
+    FlatTable &operator=(FlatTable rhs) {
+        swap(rhs);
+        return *this;
+    }
+
+    void swap(FlatTable &rhs) noexcept {
+        std::swap(dist_, rhs.dist_);
+        std::swap(entries_, rhs.entries_);
+        std::swap(capacity_, rhs.capacity_);
+        std::swap(size_, rhs.size_);
+        std::swap(shift_, rhs.shift_);
+    }
+
+    pure U64 size() const { return size_; }
+    pure bool empty() const { return size_ == 0; }
+    pure U64 capacity() const { return capacity_; }
+
+    pure Entry &operator[](const U64 index) { return entries_[index]; }
+    pure const Entry &operator[](const U64 index) const { return entries_[index]; }
+
+    /// Returns the index of the first occupied slot at or after [index], or capacity() if there is none.
+    pure U64 next(U64 index) const {
+        while (index < capacity_ && dist_[index] == 0) {
+            ++index;
+        }
+        return std::min(index, capacity_);
+    }
+
+    /// Returns the index of the slot holding [key], or kNone if there is none.
+    pure U64 find(const Key &key) const {
+        return_if(size_ == 0, kNone);
+        const U64 mask = capacity_ - 1;
+        U64 index = home(key);
+        for (U32 dist = 1; dist_[index] >= dist; ++dist) {
+            // Entries with the same home slot have the same distance at the same index
+            return_if(dist_[index] == dist && equal_(key_of(entries_[index]), key), index);
+            index = (index + 1) & mask;
+        }
+        return kNone;
+    }
+
+    /// Constructs an entry from [args] if [key] is not yet present.
+    /// Returns the index of the entry with [key] and true if it was inserted.
+    template <typename... Args>
+    std::pair<U64, bool> try_emplace(const Key &key, Args &&...args) {
+        const U64 existing = find(key);
+        return_if(existing != kNone, std::pair<U64, bool>(existing, false));
+        reserve(size_ + 1);
+        const U64 index = place(key);
+        construct(index, std::forward<Args>(args)...);
+        return {index, true};
+    }
+
+    /// Removes the entry at [index], moving the rest of its run back by one slot.
+    void erase(U64 index) {
+        const U64 mask = capacity_ - 1;
+        std::destroy_at(entries_ + index);
+        U64 following = (index + 1) & mask;
+        while (dist_[following] > 1) {
+            std::construct_at(entries_ + index, std::move(entries_[following]));
+            std::destroy_at(entries_ + following);
+            dist_[index] = dist_[following] - 1;
+            index = following;
+            following = (following + 1) & mask;
+        }
+        dist_[index] = 0;
+        --size_;
+    }
+
+    /// Removes all entries, keeping the allocated capacity.
+    void clear() {
+        for (U64 i = next(0); i < capacity_; i = next(i + 1)) {
+            std::destroy_at(entries_ + i);
+            dist_[i] = 0;
+        }
+        size_ = 0;
+    }
+
+    /// Grows the table if needed to hold [count] entries without exceeding the maximum load factor.
+    void reserve(const U64 count) {
+        return_if(count * kLoadDen <= capacity_ * kLoadNum);
+        U64 slots = std::max(capacity_ * 2, kMinCapacity);
+        while (count * kLoadDen > slots * kLoadNum) {
+            slots *= 2;
+        }
+        FlatTable grown;
+        grown.allocate(slots);
+        for (U64 i = next(0); i < capacity_; i = next(i + 1)) {
+            grown.construct(grown.place(key_of(entries_[i])), std::move(entries_[i]));
+        }
+        swap(grown);
+    }
+
+private:
+    static constexpr U64 kLoadNum = 7; // Maximum load factor numerator
+    static constexpr U64 kLoadDen = 8; // Maximum load factor denominator
+
+    pure static const Key &key_of(const Entry &entry) { return KeyOf()(entry); }
+
+    /// Returns the slot [key] hashes to, mixing the hash so that e.g. aligned pointers spread across all slots.
+    pure U64 home(const Key &key) const { return (hash_(key) * 0x9E3779B97F4A7C15ull) >> shift_; }
+
+    /// Claims the slot for a new, absent [key], shifting later entries in its run forward by one slot.
+    /// The caller must construct the entry at the returned index.
+    U64 place(const Key &key) {
+        const U64 mask = capacity_ - 1;
+        U64 index = home(key);
+        U32 dist = 1;
+        while (dist_[index] >= dist) {
+            index = (index + 1) & mask;
+            ++dist;
+        }
+        U64 vacant = index;
+        while (dist_[vacant] != 0) {
+            vacant = (vacant + 1) & mask;
+        }
+        while (vacant != index) {
+            const U64 prev = (vacant - 1) & mask;
+            std::construct_at(entries_ + vacant, std::move(entries_[prev]));
+            std::destroy_at(entries_ + prev);
+            dist_[vacant] = dist_[prev] + 1;
+            vacant = prev;
+        }
+        dist_[index] = dist;
+        return index;
+    }
+
+    template <typename... Args>
+    void construct(const U64 index, Args &&...args) {
+        std::construct_at(entries_ + index, std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    void allocate(const U64 slots) {
+        capacity_ = slots;
+        shift_ = 64 - std::countr_zero(slots);
+        dist_ = std::make_unique<U32[]>(slots);
+        entries_ = std::allocator<Entry>().allocate(slots);
+    }
+
+    void deallocate() {
+        clear();
+        if (entries_ != nullptr) {
+            std::allocator<Entry>().deallocate(entries_, capacity_);
+        }
+        entries_ = nullptr;
+        dist_ = nullptr;
+        capacity_ = 0;
+    }
+
+    std::unique_ptr<U32[]> dist_ = nullptr; // 0 if the slot is empty, otherwise 1 + distance from the home slot
+    Entry *entries_ = nullptr;              // Uninitialized unless the slot is occupied
+    U64 capacity_ = 0;                      // Always zero or a power of two
+    U64 size_ = 0;
+    U32 shift_ = 64;
+    [[no_unique_address]] Hash hash_;
+    [[no_unique_address]] Equal equal_;
+};
+
+/**
+ * @class FlatIterator
+ * @brief Concrete forward iterator over the occupied slots of a FlatTable.
+ * @tparam Table - The table type, const qualified for immutable iterators.
+ * @tparam Entry - The entry type, const qualified for immutable iterators.
+ */
+template <typename Table, typename Entry>
+class FlatIterator {
+public:
+    using value_type = std::remove_const_t<Entry>;
+    using difference_type = std::ptrdiff_t;
+    using reference = Entry &;
+    using pointer = Entry *;
+    using iterator_category = std::forward_iterator_tag;
+
+    FlatIterator() = default;
+    FlatIterator(Table *table, const U64 index) : table_(table), index_(index) {}
+
+    /// Implicitly converts a mutable iterator to an immutable one.
+    template <typename MTable, typename MEntry>
+        requires(std::is_const_v<Table> && std::is_same_v<const MTable, Table>)
+    FlatIterator(const FlatIterator<MTable, MEntry> &rhs) : table_(rhs.table_), index_(rhs.index_) {}
+
+    pure reference operator*() const { return (*table_)[index_]; }
+    pure pointer operator->() const { return &(*table_)[index_]; }
+
+    FlatIterator &operator++() {
+        index_ = table_->next(index_ + 1);
+        return *this;
+    }
+    FlatIterator operator++(int) {
+        FlatIterator prev = *this;
+        ++*this;
+        return prev;
+    }
+
+    pure bool operator==(const FlatIterator &rhs) const { return index_ == rhs.index_; }
+
+    /// Returns the index of the slot this iterator points to.
+    pure U64 index() const { return index_; }
+
+private:
+    template <typename, typename>
+    friend class FlatIterator;
+
+    Table *table_ = nullptr;
+    U64 index_ = 0;
+};
+
+} // namespace nvl::detail
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include "nvl/data/Iterator.h"
+#include "nvl/data/Range.h"
+#include "nvl/macros/Implicit.h"
+#include "nvl/macros/Pure.h"
+
+namespace nvl {
+
+/**
+ * @struct erased_iterator
+ * @brief Adapts a concrete iterator type to an AbstractIterator, e.g. to pass it across an API boundary as a Range.
+ * @tparam Iter - The concrete iterator type. Dereferencing it must return a reference.
+ */
+template <typename Iter>
+struct erased_iterator final : AbstractIteratorCRTP<erased_iterator<Iter>, std::iter_value_t<Iter>> {
+    using value_type = std::iter_value_t<Iter>;
+    class_tag(erased_iterator<Iter>, AbstractIterator<value_type>);
+
+    explicit erased_iterator(Iter iter) : iter(iter) {}
+
+    void increment() override { ++iter; }
+    const value_type *ptr() override { return &*iter; }
+
+    pure bool operator==(const erased_iterator &rhs) const override { return iter == rhs.iter; }
+
+    Iter iter;
+};
+
+/**
+ * @class IterRange
+ * @brief A pair of concrete iterators which can be iterated over any number of times.
+ *
+ * Unlike Range, iterating over an IterRange does not allocate and does not use virtual dispatch, so it should be
+ * preferred in hot loops. IterRange implicitly converts to Range where the iterator type should not matter.
+ *
+ * @tparam Iter - The concrete iterator type.
+ */
+template <typename Iter>
+class IterRange final {
+public:
+    using iterator = Iter;
+    using const_iterator = Iter;
+    using value_type = std::iter_value_t<Iter>;
+
+    IterRange() = default;
+    IterRange(Iter begin, Iter end) : begin_(begin), end_(end) {}
+
+    implicit operator Range<value_type>() const { return range(); }
+
+    /// Returns a type-erased Range over the same elements.
+    pure Range<value_type> range() const {
+        return {make_iterator<erased_iterator<Iter>>(begin_), make_iterator<erased_iterator<Iter>>(end_)};
+    }
+
+    pure bool empty() const { return begin_ == end_; }
+
+    /// Returns the number of elements in this range. Note that this is O(N) for non-random access iterators!
+    pure U64 size() const { return std::distance(begin_, end_); }
+
+    pure Iter begin() const { return begin_; }
+    pure Iter end() const { return end_; }
+
+    /// Returns true if all values in this range meet the given condition.
+    template <typename Cond>
+    pure bool all(const Cond &cond) const {
+        return std::all_of(begin_, end_, cond);
+    }
+
+    /// Returns true if at least one value in this range meet the given condition.
+    template <typename Cond>
+    pure bool exists(const Cond &cond) const {
+        return std::any_of(begin_, end_, cond);
+    }
+
+private:
+    Iter begin_;
+    Iter end_;
+};
+
+template <typename Iter>
+std::ostream &operator<<(std::ostream &os, const IterRange<Iter> &range) {
+    os << "{";
+    auto iter = range.begin();
+    const auto end = range.end();
+    if (iter != end) {
+        os << *iter;
+        ++iter;
+    }
+    for (; iter != end; ++iter) {
+        os << ", " << *iter;
+    }
+    return os << "}";
+}
+
+} // namespace nvl
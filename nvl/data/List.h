@@ -58,8 +58,7 @@ public:
     implicit operator Range<Value>() const { return range(); }
 
     pure HOT bool operator==(const List &rhs) const {
-        // HOT SPOT: Using the custom iterators slows comparison down by ~20x. Likely to do with std::__unwrap_iter?
-        return size() == rhs.size() && std::equal(_begin(), _end(), rhs._begin());
+        return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
     }
     pure bool operator!=(const List &other) const { return !(*this == other); }
 
@@ -72,23 +71,26 @@ public:
     using parent::pop_back;
     using parent::push_back;
     using parent::reserve;
+    using parent::resize;
     using parent::size;
 
-    pure MIterator<Value> begin() { return iterator::template begin<View::kMutable>(*this); }
-    pure MIterator<Value> end() { return iterator::template end<View::kMutable>(*this); }
-    pure Iterator<Value> begin() const { return iterator::template begin<View::kImmutable>(*this); }
-    pure Iterator<Value> end() const { return iterator::template end<View::kImmutable>(*this); }
+    // Iteration over the list itself uses the underlying vector's iterators, which do not allocate.
+    // Use range() or rrange() to pass the list as a type-erased Range.
+    using parent::begin;
+    using parent::end;
+    using parent::rbegin;
+    using parent::rend;
 
-    pure MIterator<Value> rbegin() { return reverse_iterator::template begin<View::kMutable>(*this); }
-    pure MIterator<Value> rend() { return reverse_iterator::template end<View::kMutable>(*this); }
-    pure Iterator<Value> rbegin() const { return reverse_iterator::template begin<View::kImmutable>(*this); }
-    pure Iterator<Value> rend() const { return reverse_iterator::template end<View::kImmutable>(*this); }
-
-    pure MRange<Value> range() { return {begin(), end()}; }
-    pure Range<Value> range() const { return {begin(), end()}; }
+    pure MRange<Value> range() {
+        return {iterator::template begin<View::kMutable>(*this), iterator::template end<View::kMutable>(*this)};
+    }
+    pure Range<Value> range() const { return {iterator::begin(*this), iterator::end(*this)}; }
 
-    pure MRange<Value> rrange() { return {rbegin(), rend()}; }
-    pure Range<Value> rrange() const { return {rbegin(), rend()}; }
+    pure MRange<Value> rrange() {
+        return {reverse_iterator::template begin<View::kMutable>(*this),
+                reverse_iterator::template end<View::kMutable>(*this)};
+    }
+    pure Range<Value> rrange() const { return {reverse_iterator::begin(*this), reverse_iterator::end(*this)}; }
 
     pure const Value *get_back() const { return empty() ? nullptr : &back(); }
 
@@ -29,9 +29,14 @@ public:
     using parent::at;
     using parent::clear;
     using parent::empty;
-    using parent::end;
     using parent::size;
 
+    // Iteration over the map itself uses the underlying map's iterators, which do not allocate.
+    // Use entries(), values(), or keys() to pass the map as a type-erased Range.
+    using parent::begin;
+    using parent::end;
+    using parent::find;
+
     /**
      * @struct entry_iterator
      * @brief An iterator over a map's (key, value) pairs.
@@ -134,16 +139,10 @@ public:
         return iter->second;
     }
 
-    template <typename... Args>
-    std::pair<Iterator<Entry>, bool> &try_emplace(const K &key, Args &&...args) {
-        auto [iter, added] = parent::try_emplace(key, std::forward<Args>(args)...);
-        return {make_iterator<entry_iterator>(iter), added};
-    }
+    using parent::try_emplace;
 
-    Map &erase(Iterator<Entry> iter) {
-        if (auto *entry_iter = iter.template dyn_cast<entry_iterator>()) {
-            parent::erase(*entry_iter);
-        }
+    Map &erase(parent::const_iterator iter) {
+        parent::erase(iter);
         return *this;
     }
 
@@ -152,15 +151,6 @@ public:
         return *this;
     }
 
-    pure Iterator<Entry> find(const K &key) const {
-        typename parent::const_iterator iter = parent::find(key);
-        return make_iterator<entry_iterator>(iter);
-    }
-    pure MIterator<Entry> find(const K &key) {
-        typename parent::const_iterator iter = parent::find(key);
-        return make_miterator<entry_iterator>(iter);
-    }
-
     pure V *get(const K &key) const {
         // Ideally this would return Maybe<V &>, but Maybe can't hold a reference right now.
         if (auto iter = parent::find(key); parent::end() != iter) {
@@ -201,13 +191,11 @@ public:
     pure bool operator==(const Map &other) const { return std::operator==(*this, other); }
     pure bool operator!=(const Map &other) const { return std::operator!=(*this, other); }
 
-    pure MRange<Entry> entries() { return {begin(), end()}; }
-    pure Range<Entry> entries() const { return {begin(), end()}; }
-
-    pure MIterator<Entry> begin() { return entry_iterator::template begin<View::kMutable>(*this); }
-    pure MIterator<Entry> end() { return entry_iterator::template end<View::kMutable>(*this); }
-    pure Iterator<Entry> begin() const { return entry_iterator::template begin<View::kImmutable>(*this); }
-    pure Iterator<Entry> end() const { return entry_iterator::template end<View::kImmutable>(*this); }
+    pure MRange<Entry> entries() {
+        return {entry_iterator::template begin<View::kMutable>(*this),
+                entry_iterator::template end<View::kMutable>(*this)};
+    }
+    pure Range<Entry> entries() const { return {entry_iterator::begin(*this), entry_iterator::end(*this)}; }
 
     pure MRange<V> values() { return {values_begin(), values_end()}; }
     pure Range<V> values() const { return {values_begin(), values_end()}; }
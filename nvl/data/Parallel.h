@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Pure.h"
+#include "nvl/macros/ReturnIf.h"
+
+namespace nvl {
+
+/**
+ * @class ThreadPool
+ * @brief Runs work on a fixed set of persistent worker threads plus the calling thread.
+ *
+ * Workers are started once when the pool is created and sleep between calls, rather than being started and joined
+ * for every call. Only one call may run on a pool at a time.
+ */
+class ThreadPool {
+public:
+    /// Creates a pool which runs work on up to [threads] threads, including the calling thread.
+    explicit ThreadPool(const U64 threads) {
+        for (U64 t = 1; t < threads; ++t) {
+            workers_.emplace_back([this, t] { work(t); });
+        }
+    }
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (std::thread &worker : workers_) {
+            worker.join();
+        }
+    }
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /// Returns the number of threads used by this pool, including the calling thread.
+    pure U64 threads() const { return workers_.size() + 1; }
+
+    /// Calls [func] on each index in [0, n), splitting indices into one contiguous chunk per thread.
+    /// Returns once all calls have completed. [func] must be safe to call concurrently for distinct indices.
+    template <typename Func> // U64 => void
+    void parallel_for(const U64 n, Func func) {
+        const U64 chunks = std::max<U64>(1, std::min(threads(), n));
+        const U64 chunk = (n + chunks - 1) / chunks;
+        run(chunks, [&](const U64 t) {
+            const U64 end = std::min(n, (t + 1) * chunk);
+            for (U64 i = t * chunk; i < end; ++i) {
+                func(i);
+            }
+        });
+    }
+
+private:
+    /// Runs [task] on chunks [0, chunks), with chunk 0 on the calling thread and chunk t on worker t.
+    void run(const U64 chunks, const std::function<void(U64)> &task) {
+        if (chunks > 1) {
+            std::lock_guard lock(mutex_);
+            task_ = &task;
+            chunks_ = chunks;
+            pending_ = chunks - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+        task(0);
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        task_ = nullptr;
+    }
+
+    void work(const U64 t) {
+        U64 seen = 0;
+        std::unique_lock lock(mutex_);
+        while (true) {
+            start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            return_if(stop_);
+            seen = generation_;
+            if (t < chunks_) {
+                const std::function<void(U64)> *task = task_;
+                lock.unlock();
+                (*task)(t);
+                lock.lock();
+                if (--pending_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_; // Signals workers when a new call starts or the pool stops
+    std::condition_variable done_;  // Signals the caller when the last worker finishes its chunk
+    const std::function<void(U64)> *task_ = nullptr;
+    U64 chunks_ = 0;     // Number of chunks in the current call
+    U64 pending_ = 0;    // Number of worker chunks in the current call which have not finished
+    U64 generation_ = 0; // Incremented on each call with more than one chunk
+    bool stop_ = false;
+};
+
+} // namespace nvl
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+
+#include "nvl/data/List.h"
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Expand.h"
+#include "nvl/macros/Pure.h"
+
+namespace nvl {
+
+/**
+ * @class Pool
+ * @brief Slab allocator for objects addressed by 32-bit indices.
+ *
+ * Objects are stored in fixed-size slabs, so their addresses are stable for the lifetime of the pool. Released slots
+ * are kept on a free list and handed out again by later calls to alloc(). Slots are never destructed on release, so
+ * any storage owned by a recycled object (e.g. a List's capacity) is also reused. Callers are responsible for
+ * resetting the state of an object returned by alloc().
+ *
+ * @tparam T - Type of object being stored. Must be default constructible.
+ * @tparam kSlabSize - Number of objects per slab. Must be a power of 2.
+ */
+template <typename T, U64 kSlabSize = 64>
+    requires std::is_default_constructible_v<T>
+class Pool {
+public:
+    static_assert((kSlabSize & (kSlabSize - 1)) == 0, "Slab size must be a power of 2");
+    static constexpr U32 kNone = std::numeric_limits<U32>::max();
+
+    Pool() = default;
+    Pool(const Pool &) = delete;
+    Pool &operator=(const Pool &) = delete;
+
+    /// Returns the index of an unused slot, reusing a previously released slot if one is available.
+    U32 alloc() {
+        ++size_;
+        if (!free_.empty()) {
+            const U32 index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        if (capacity_ == slabs_.size() * kSlabSize) {
+            slabs_.push_back(std::make_unique<T[]>(kSlabSize));
+        }
+        return static_cast<U32>(capacity_++);
+    }
+
+    /// Returns the slot at [index] to the free list. The object itself is not destroyed.
+    void release(const U32 index) {
+        --size_;
+        free_.push_back(index);
+    }
+
+    pure expand T &operator[](const U32 index) { return slabs_[index / kSlabSize][index % kSlabSize]; }
+    pure expand const T &operator[](const U32 index) const { return slabs_[index / kSlabSize][index % kSlabSize]; }
+
+    /// Returns the number of slots currently in use.
+    pure U64 size() const { return size_; }
+
+    /// Returns the number of slots which have been allocated, including those on the free list.
+    pure U64 capacity() const { return capacity_; }
+
+    pure bool empty() const { return size_ == 0; }
+
+    /// Marks all slots as unused. Keeps all allocated slabs for reuse.
+    void clear() {
+        free_.clear();
+        for (U64 i = capacity_; i > 0; --i) {
+            free_.push_back(static_cast<U32>(i - 1));
+        }
+        size_ = 0;
+    }
+
+private:
+    List<std::unique_ptr<T[]>> slabs_;
+    List<U32> free_;
+    U64 capacity_ = 0;
+    U64 size_ = 0;
+};
+
+} // namespace nvl
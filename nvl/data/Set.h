@@ -70,27 +70,24 @@ public:
         return *this;
     }
 
-    pure Iterator<Value> find(const Value &value) const {
-        typename parent::const_iterator iter = parent::find(value);
-        return make_iterator<iterator>(iter);
-    }
+    // Iteration over the set itself uses the underlying set's iterators, which do not allocate.
+    // Use values() to pass the set as a type-erased Range.
+    using parent::begin;
+    using parent::end;
+    using parent::find;
 
     pure bool has(const Value &value) const { return parent::contains(value); }
 
-    pure MIterator<Value> begin() { return iterator::template begin<View::kMutable>(*this); }
-    pure MIterator<Value> end() { return iterator::template end<View::kMutable>(*this); }
-    pure Iterator<Value> begin() const { return iterator::template begin<View::kImmutable>(*this); }
-    pure Iterator<Value> end() const { return iterator::template end<View::kImmutable>(*this); }
-
-    pure MRange<Value> values() { return {begin(), end()}; }
-    pure Range<Value> values() const { return {begin(), end()}; }
+    pure MRange<Value> values() {
+        return {iterator::template begin<View::kMutable>(*this), iterator::template end<View::kMutable>(*this)};
+    }
+    pure Range<Value> values() const { return {iterator::begin(*this), iterator::end(*this)}; }
 
     pure bool operator==(const Set &rhs) const {
         return_if(size() != rhs.size(), false);
-        const Iterator<Value> rhs_end = rhs.end();
-        for (Iterator<Value> iter = begin(); iter != end(); ++iter) {
-            auto rhs_iter = rhs.find(*iter);
-            return_if(rhs_iter == rhs_end || *iter != *rhs_iter, false);
+        for (const Value &value : *this) {
+            auto rhs_iter = rhs.find(value);
+            return_if(rhs_iter == rhs.end() || value != *rhs_iter, false);
         }
         return true;
     }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "nvl/data/IterRange.h"
 #include "nvl/data/List.h"
 #include "nvl/geo/Tuple.h"
 #include "nvl/geo/Volume.h"
@@ -22,12 +23,14 @@ public:
 
     explicit Tensor(Idx shape, T init) : shape_(shape), data_(shape_.product(), init) { strides_ = shape_.strides(); }
 
-    pure MIterator<T> begin() { return data_.begin(); }
-    pure MIterator<T> end() { return data_.end(); }
-    pure Iterator<T> begin() const { return data_.begin(); }
-    pure Iterator<T> end() const { return data_.end(); }
+    pure auto begin() { return data_.begin(); }
+    pure auto end() { return data_.end(); }
+    pure auto begin() const { return data_.begin(); }
+    pure auto end() const { return data_.end(); }
 
-    pure Range<Idx> indices() const { return Volume<N, I64>(Idx::zero, shape_).indices(); }
+    pure IterRange<typename Volume<N, I64>::idx_iterator> indices() const {
+        return Volume<N, I64>(Idx::zero, shape_).indices();
+    }
 
     /// Returns the first index where the given predicate is true. Returns None otherwise.
     template <typename PredicateFunc>
@@ -1,6 +1,10 @@
 #pragma once
 
-#include "nvl/data/Map.h"
+#include <span>
+
+#include "nvl/data/DenseUnionFind.h"
+#include "nvl/data/FlatMap.h"
+#include "nvl/data/List.h"
 #include "nvl/data/Range.h"
 #include "nvl/data/Set.h"
 #include "nvl/macros/Aliases.h"
@@ -13,6 +17,7 @@ namespace nvl {
  * @brief Data structure which organizes items into "equivalent" groups.
  *
  * Items are added in pairs, where adding two items together marks them as being in the same group.
+ * Each item is assigned a dense id when it is first added, and the sets themselves are kept in a DenseUnionFind.
  *
  * @tparam Item The item type being stored.
  * @tparam Hash The hash function used for items in each set.
@@ -24,86 +29,54 @@ public:
 
     /// Inserts a single element into its own set.
     U64 add(const Item &a) {
+        if (const U64 *id = ids_.get(a)) {
+            return *id;
+        }
         changed_ = true;
-        const U64 id_a = ids_.get_or(a, 0);
-        return_if(id_a != 0, id_a);
-        ++count_;
-        groups_[count_].insert(a);
-        make(count_);
-        return ids_[a] = count_;
+        items_.push_back(a);
+        return ids_[a] = dense_.add();
     }
 
     /// Marks elements `a` and `b` as equivalent, inserting them into a new set or combining their existing sets
     /// if either are already present.
     UnionFind &add(const Item &a, const Item &b) {
-        merge(add(a), add(b));
+        const U64 id_a = add(a);
+        const U64 id_b = add(b);
+        changed_ = dense_.merge(id_a, id_b) || changed_;
         return *this;
     }
 
     /// Returns true if the given item was added to any set.
-    pure bool has(const Item &item) const { return ids_.contains(item); }
+    pure bool has(const Item &item) const { return ids_.has(item); }
 
     /// Returns an iterator over all disjoint sets.
     pure Range<Group> sets() const {
         update_groups();
-        return groups_.values();
+        return groups_.range();
     }
 
     /// Returns the current number of sets.
-    pure U64 num_sets() const {
-        Set<U64> sets;
-        for (const auto &[item, id] : ids_) {
-            sets.insert(find(id));
-        }
-        return sets.size();
-    }
+    pure U64 num_sets() const { return dense_.num_sets(); }
 
 private:
     void update_groups() const {
         if (changed_) {
             changed_ = false;
             groups_.clear();
-            for (const auto &[item, id] : ids_) {
-                const U64 set = find(id);
-                groups_[set].insert(item);
+            for (const std::span<const U64> ids : dense_.sets()) {
+                Group &group = groups_.emplace_back();
+                for (const U64 id : ids) {
+                    group.insert(items_[id]);
+                }
             }
         }
     }
 
-    // Internals adapted from https://cp-algorithms.com/data_structures/disjoint_set_union.html
-    U64 find(const U64 v) const {
-        U64 value = v;
-        while (value != parent_.at(value)) {
-            value = parent_.at(value);
-        }
-        // "Path compression" - memoize the root to avoid traversing the whole path each time
-        parent_[v] = value;
-        return value;
-    }
-
-    void make(const U64 v) {
-        parent_[v] = v;
-        size_[v] = 1;
-    }
-
-    void merge(U64 a, U64 b) {
-        a = find(a);
-        b = find(b);
-        if (a != b) {
-            // Union by size
-            if (size_[a] < size_[b])
-                std::swap(a, b);
-            parent_[b] = a;
-            size_[a] += size_[b];
-        }
-    }
-
-    U64 count_ = 0;
+    DenseUnionFind dense_;
+    FlatMap<Item, U64, Hash> ids_; // Maps each item to its dense id
+    List<Item> items_;             // Maps each dense id back to its item
     mutable bool changed_ = false;
-    mutable Map<U64, Group> groups_;
-    Map<Item, U64, Hash> ids_;
-    mutable Map<U64, U64> parent_;
-    Map<U64, U64> size_;
+    mutable List<Group> groups_;
 };
 
 } // namespace nvl
@@ -72,10 +72,10 @@ public:
         } else if constexpr (N == 3) {
             const auto color = material_->color.highlight(scale);
             const auto edge_color = color.highlight(Color::kDarker);
-            for (const Rel<Part> &part : this->parts()) {
-                window->fill_cube(color, part->box + loc);
-                window->line_cube(edge_color, part->box + loc);
-            }
+            // The surface is cached until parts change, and is relative to loc so it is unchanged by moving
+            const List<Edge> &surface = this->tree().surface();
+            window->fill_faces(color, {surface.begin(), surface.end()}, loc);
+            window->line_faces(edge_color, {surface.begin(), surface.end()}, loc);
         }
     }
 
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
+
 #include "nvl/actor/Actor.h"
 #include "nvl/actor/Part.h"
 #include "nvl/actor/Status.h"
+#include "nvl/data/Maybe.h"
 #include "nvl/geo/BRTree.h"
+#include "nvl/geo/Intersect.h"
+#include "nvl/geo/Merge.h"
 #include "nvl/geo/Tuple.h"
 #include "nvl/macros/Abstract.h"
 #include "nvl/macros/Aliases.h"
@@ -26,6 +32,12 @@ public:
     using Tree = BRTree<N, Part, Rel<Part>, kMaxEntries, kGridExpMin>;
     using Intersect = Tree::Intersect;
 
+    /// Result of sweeping this entity along a displacement.
+    struct Sweep {
+        Pos<N> delta;        // Furthest displacement along the path without overlapping other entities
+        List<Face> contacts; // Faces of this entity which made contact along the path
+    };
+
     explicit Entity(Pos<N> loc, Range<Rel<Part>> parts = {}) : parts_(loc, parts) {}
     explicit Entity(Pos<N> loc, Range<Part> parts) : parts_(loc, parts) {}
 
@@ -37,10 +49,23 @@ public:
 
     pure Range<Rel<Edge>> edges() const { return parts_.edges(); }
     pure Range<Rel<Part>> parts() const { return parts_.items(); }
+    pure U64 num_parts() const { return parts_.size(); }
 
     pure Set<Rel<Part>> parts(const Box<N> &box) const { return parts_[box]; }
     pure Set<Rel<Part>> parts(const Pos<N> &pos) const { return parts_[pos]; }
 
+    /// Calls [func] on each part in the given volume exactly once. Stops early if [func] returns WalkResult::kExit.
+    template <typename VisitFunc> // Rel<Part> => WalkResult | void
+    expand void for_each_in(const Box<N> &box, VisitFunc func) const {
+        parts_.for_each_in(box, func);
+    }
+
+    /// Returns true if any part in the given volume meets the condition [cond].
+    template <typename Cond> // Rel<Part> => bool
+    pure expand bool any_in(const Box<N> &box, Cond cond) const {
+        return parts_.any_in(box, cond);
+    }
+
     /// Returns the first part stored in the given volume, if one exists.
     pure expand Maybe<Rel<Part>> first(const Box<N> &box) const { return parts_.first(box); }
     pure expand Maybe<Rel<Part>> first(const Pos<N> &pos) const { return parts_.first(pos); }
@@ -56,14 +81,35 @@ public:
         return parts().all([](const Rel<Part> &part) { return part->material->falls; });
     }
 
-    Status tick(const List<Message> &messages) override;
+    Status tick(Messages messages) override;
 
     void bind(World<N> *world) { world_ = world; }
 
+    /// Computes this entity's velocity for the next tick against the current state of the world.
+    /// Used to plan velocities for many entities concurrently, so the world must not be modified meanwhile.
+    /// The planned velocity is used by the next tick unless this entity receives messages in that tick.
+    void plan_velocity() { planned_velocity_ = next_velocity(); }
+
+    /// Returns the volume this entity would sweep through when moving by its planned velocity, if it has one.
+    pure Maybe<Box<N>> planned_sweep() const {
+        return_if(!planned_velocity_.has_value(), None);
+        const Box<N> box = bbox();
+        return bounding_box(box, box + *planned_velocity_);
+    }
+
+    /// Discards the planned velocity, such that the next tick computes its velocity against the current world.
+    void discard_plan() { planned_velocity_ = None; }
+
+    /// Returns true if this entity is resting on another entity.
+    /// The supporting entity is cached until either entity moves, the support is removed, or a message arrives.
     pure bool has_below() const;
 
     pure Set<Actor> above() const;
 
+    /// Moves this entity's volume along [delta], stopping each dimension at the first contact with other entities.
+    /// Motion in the remaining dimensions continues along the path, e.g. sliding along a wall.
+    pure Sweep sweep(const Pos<N> &delta) const;
+
     /// Sends an action to the destination actor with this entity as the sender.
     template <typename Msg, typename... Args>
     void send(const Actor dst, Args &&...args) {
@@ -71,9 +117,10 @@ public:
     }
 
     /// Sends an action to the destination actor(s) with this entity as the sender.
+    /// Returns the number of distinct recipients.
     template <typename Msg, typename... Args>
-    void send(const Range<Actor> &dst, Args &&...args) {
-        world_->template send<Msg>(self(), dst, std::forward<Args>(args)...);
+    U64 send(const Range<Actor> &dst, Args &&...args) {
+        return world_->template send<Msg>(self(), dst, std::forward<Args>(args)...);
     }
 
     /// Spawns a new actor in the world with this entity as the creator.
@@ -90,14 +137,31 @@ protected:
     pure Pos<N> next_velocity() const;
 
     virtual Status receive(const Message &message);
-    Status receive(const List<Message> &messages);
+    Status receive(Messages messages);
 
     Status hit(const List<Hit<N>> &hits);
 
+    /// Merges adjacent parts with the same material and health into fewer, larger parts.
+    /// Only runs once the number of parts has doubled since the last time, as each hit splits the parts it hits.
+    /// Returns true if any parts were merged.
+    bool coalesce();
+
+    static constexpr U64 kMinPartsToCoalesce = 16;
+
     /// State
     Tree parts_;
     Pos<N> velocity_ = Pos<N>::zero;
     Pos<N> accel_ = Pos<N>::zero;
+    Maybe<Pos<N>> planned_velocity_ = None;
+    U64 coalesced_parts_ = 0; // Number of parts after the last coalesce
+
+    /// Cache
+    struct Support {
+        Actor actor;      // Entity this one was last found resting on
+        Pos<N> actor_loc; // Location of the supporting entity at the time
+        Pos<N> loc;       // Location of this entity at the time
+    };
+    mutable Maybe<Support> support_ = None;
 
     /// Binds
     World<N> *world_ = nullptr;
@@ -109,14 +173,11 @@ Set<Actor> Entity<N>::above() const {
     for (const Rel<Edge> &edge : parts_.edges()) {
         if (World<N>::is_up(edge->dim, edge->dir)) {
             const Box<N> box = edge->box + loc();
-            for (const Actor &actor : world_->entities(box)) {
-                if (auto *entity = actor.dyn_cast<Entity<N>>(); entity && entity != this) {
-                    auto overlapping = entity->parts(box);
-                    if (!overlapping.empty()) {
-                        above.insert(actor);
-                    }
+            world_->for_each_in(box, [&](const Actor &actor) {
+                if (auto *entity = actor.dyn_cast<Entity<N>>(); entity && entity != this && entity->exists(box)) {
+                    above.insert(actor);
                 }
-            }
+            });
         }
     }
     return above;
@@ -124,46 +185,85 @@ Set<Actor> Entity<N>::above() const {
 
 template <U64 N>
 bool Entity<N>::has_below() const {
+    if (support_.has_value()) {
+        const Support &support = *support_;
+        // The support's address may have been reused by a different kind of actor after it was removed
+        const Entity<N> *entity = world_->has(support.actor) ? support.actor.template dyn_cast<Entity<N>>() : nullptr;
+        return_if(entity && support.loc == loc() && entity->loc() == support.actor_loc, true);
+        support_ = None;
+    }
     for (const Rel<Edge> &edge : parts_.edges()) {
         if (World<N>::is_down(edge->dim, edge->dir)) {
             const Box<N> box = edge->box + loc();
-            for (const Actor &actor : world_->entities(box)) {
-                if (const Entity<N> *entity = actor.dyn_cast<Entity<N>>(); entity && entity != this) {
-                    return_if(entity->exists(box), true);
+            world_->for_each_in(box, [&](const Actor &actor) {
+                const Entity<N> *entity = actor.dyn_cast<Entity<N>>();
+                if (entity && entity != this && entity->exists(box)) {
+                    support_ = Support{.actor = actor, .actor_loc = entity->loc(), .loc = loc()};
+                    return WalkResult::kExit;
                 }
-            }
+                return WalkResult::kRecurse;
+            });
+            return_if(support_.has_value(), true);
         }
     }
     return false;
 }
 
 template <U64 N>
-Pos<N> Entity<N>::next_velocity() const {
-    const Pos<N> accel = accel_ + (falls() && !has_below() ? world_->kGravity : Pos<N>::zero);
-    Pos<N> velocity;
+typename Entity<N>::Sweep Entity<N>::sweep(const Pos<N> &delta) const {
+    Sweep result{.delta = delta, .contacts = {}};
+    return_if(delta == Pos<N>::zero, result);
+
+    // The first contact is always made by an exposed face leading in the direction of motion, so only the layer
+    // just inside each such edge needs to be swept rather than every part.
+    List<Box<N>> leading;
+    for (const Rel<Edge> &edge : parts_.edges()) {
+        const I64 d = delta[edge->dim];
+        if (edge->dir == Dir::Pos ? d > 0 : d < 0) {
+            const I64 inward = edge->dir == Dir::Pos ? -1 : 1;
+            leading.push_back(edge->box + Pos<N>::unit(edge->dim, inward) + loc());
+        }
+    }
+
+    // Collect all possible obstacles with a single query over the volume swept by the entire entity
+    Box<N> swept = bbox();
     for (U64 i = 0; i < N; ++i) {
-        const I64 v = velocity_[i];
-        const I64 a = accel[i];
-        I64 v_next = std::clamp(v + a, -world_->kMaxVelocity, world_->kMaxVelocity);
-        if (v != 0 || a != 0) {
-            for (const Rel<Part> &part : parts()) {
-                const Box<N> box = part->box + loc();
-                const I64 x = v >= 0 ? box.end[i] : box.min[i];
-                const Box<N> trj = box.with(i, x, x + v_next);
-                for (Actor actor : world_->entities(trj)) {
-                    if (auto *entity = actor.dyn_cast<Entity<N>>(); entity && entity != this) {
-                        const I64 entity_x = entity->loc()[i];
-                        for (const Rel<Part> &other : entity->parts(trj)) {
-                            v_next = v >= 0 ? std::clamp<I64>(other->box.min[i] + entity_x - x, 0, v_next)
-                                            : std::clamp<I64>(x - entity_x - other->box.end[i], v_next, 0);
-                        }
-                    }
+        (delta[i] > 0 ? swept.end[i] : swept.min[i]) += delta[i];
+    }
+    List<Box<N>> obstacles;
+    world_->for_each_in(swept, [&](const Actor &actor) {
+        if (auto *entity = actor.dyn_cast<Entity<N>>(); entity && entity != this) {
+            const Pos<N> &entity_loc = entity->loc();
+            entity->for_each_in(swept, [&](const Rel<Part> &part) { obstacles.push_back(part->box + entity_loc); });
+        }
+    });
+
+    // Each contact stops motion in one dimension, so repeat with the shortened path until it is clear
+    while (result.delta != Pos<N>::zero) {
+        Maybe<Impact> first = None;
+        for (U64 i = 0; i < leading.size(); ++i) {
+            for (U64 j = 0; j < obstacles.size(); ++j) {
+                const Maybe<Impact> impact = nvl::sweep(leading[i], result.delta, obstacles[j]);
+                if (impact.has_value() && (!first.has_value() || impact->time < first->time)) {
+                    first = impact;
                 }
             }
         }
-        velocity[i] = v_next;
+        return_if(!first.has_value(), result);
+        result.delta[first->face.dim] = first->gap;
+        result.contacts.push_back(first->face);
     }
-    return velocity;
+    return result;
+}
+
+template <U64 N>
+Pos<N> Entity<N>::next_velocity() const {
+    const Pos<N> accel = accel_ + (falls() && !has_below() ? world_->kGravity : Pos<N>::zero);
+    Pos<N> velocity;
+    for (U64 i = 0; i < N; ++i) {
+        velocity[i] = std::clamp(velocity_[i] + accel[i], -world_->kMaxVelocity, world_->kMaxVelocity);
+    }
+    return sweep(velocity).delta;
 }
 
 template <U64 N>
@@ -175,7 +275,7 @@ Status Entity<N>::receive(const Message &message) {
 }
 
 template <U64 N>
-Status Entity<N>::receive(const List<Message> &messages) {
+Status Entity<N>::receive(const Messages messages) {
     List<Hit<N>> hits;
     Status status = Status::kNone;
     for (const auto &message : messages) {
@@ -200,24 +300,33 @@ template <U64 N>
 Status Entity<N>::hit(const List<Hit<N>> &hits) {
     Set<Actor> neighbors;
     bool was_hit = false;
+    bool was_removed = false; // True if any volume was removed, which may disconnect the remaining parts
     for (const Hit<N> &hit : hits) {
         const Set<Rel<Part>> hit_parts = parts(hit.box);
         const Box<N> local_box = hit.box - parts_.loc;
         was_hit = was_hit || !hit_parts.empty();
         for (const Rel<Part> &part : hit_parts) {
             const Box<N> area = part->bbox().widened(1);
-            neighbors.insert(world_->entities(area).values());
+            world_->for_each_in(area, [&](const Actor &actor) { neighbors.insert(actor); });
             if (part->health > hit.strength) {
                 parts_.emplace(part->bbox().intersect(local_box).value(), part->material, part->health - hit.strength);
+            } else {
+                was_removed = true;
             }
             for (auto diff : part->diff(local_box)) {
                 parts_.insert(diff);
             }
-            parts_.remove(part);
         }
+        parts_.remove(hit_parts.values()); // Removed together, so the parts' bounds are recomputed at most once
     }
 
     if (was_hit) {
+        coalesce();
+        if (!was_removed) {
+            // Damaged parts are replaced by pieces covering the same volume, so the entity is still connected
+            send<Notify>(neighbors.values(), Notify::kChanged);
+            return Status::kNone;
+        }
         const List<Set<Rel<Part>>> components = parts_.components();
         const bool was_broken = components.size() != 1;
         const auto cause = was_broken ? Notify::kBroken : Notify::kChanged;
@@ -228,21 +337,43 @@ Status Entity<N>::hit(const List<Hit<N>> &hits) {
 }
 
 template <U64 N>
-Status Entity<N>::tick(const List<Message> &messages) {
+bool Entity<N>::coalesce() {
+    return_if(parts_.size() < std::max(kMinPartsToCoalesce, 2 * coalesced_parts_), false);
+    List<Part> parts;
+    parts.reserve(parts_.size());
+    for (const Rel<Part> &part : parts_.items()) {
+        parts.push_back(part.raw());
+    }
+    const List<Part> merged = merge_adjacent<N>(parts, [](const Part &part) {
+        return std::make_pair(reinterpret_cast<std::uintptr_t>(part.material.ptr()), part.health);
+    });
+    coalesced_parts_ = merged.size();
+    return_if(merged.size() == parts.size(), false);
+    parts_.clear();
+    parts_.insert(merged.range());
+    return true;
+}
+
+template <U64 N>
+Status Entity<N>::tick(const Messages messages) {
     // Early exit if we aren't attached to a world
     return_if(world_ == nullptr, Status::kNone);
+    const Maybe<Pos<N>> planned_velocity = std::exchange(planned_velocity_, None);
+    if (!messages.empty()) {
+        support_ = None; // Neighbors or this entity's parts may have changed
+    }
 
     Status status = receive(messages);
     return_if(status == Status::kDied, status);
 
     const Pos<N> init_velocity = velocity_;
-    velocity_ = next_velocity();
+    // Messages can change this entity's parts or acceleration, which invalidates any planned velocity
+    velocity_ = planned_velocity.has_value() && messages.empty() ? *planned_velocity : next_velocity();
 
     if (velocity_ != Pos<N>::zero) {
         if (init_velocity == Pos<N>::zero) {
-            // When starting to move, notify anything above
-            const Set<Actor> neighbors = above();
-            send<Notify>(neighbors.values(), Notify::kMoved);
+            // When starting to move, wake the island of entities resting on top of this one
+            world_->wake_above(self());
         }
         // Move by velocity per tick
         parts_.loc += velocity_;
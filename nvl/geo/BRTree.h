@@ -1,7 +1,10 @@
 #pragma once
 
+#include <utility>
+
 #include "nvl/geo/HasBBox.h"
 #include "nvl/geo/Line.h"
+#include "nvl/geo/Merge.h"
 #include "nvl/geo/Rel.h"
 #include "nvl/geo/RTree.h"
 #include "nvl/geo/Volume.h"
@@ -29,36 +32,136 @@ protected:
     explicit BRTreeEdges(Range<Item> items) : items_(items), changed_(true) {}
     explicit BRTreeEdges(Range<ItemRef> items) : items_(items), changed_(true) {}
 
-    void mark_changed() const { changed_ = true; }
+    /// Marks all edges as needing to be recomputed.
+    void mark_changed() const {
+        changed_ = true;
+        surface_changed_ = true;
+        dirty_.clear();
+    }
+
+    /// Marks the edges around [box] as needing to be recomputed, after adding or removing an item with bounds [box].
+    void mark_changed(const Box<N> &box) const {
+        surface_changed_ = true;
+        return_if(changed_); // Already rebuilding everything
+        dirty_.emplace_back(box.min - 1, box.end + 1);
+        if (dirty_.size() > items_.size()) {
+            mark_changed(); // Cheaper to rebuild from scratch
+        }
+    }
 
     EdgeTree &get_edges() const {
         if (changed_) {
-            // Clear the edges
             changed_ = false;
             edges_.clear();
-
-            // Recompute edges across all values
-            for (const ItemRef &item : items_.items()) {
-                for (const auto &edge : bbox(item).edges()) {
-                    List<Box<N>> overlap;
-                    for (const ItemRef &b : items_[edge.bbox()]) {
-                        overlap.push_back(bbox(b));
-                    }
-                    Range<Box<N>> overlap_range = overlap.range();
-                    for (const Edge &remain : edge.diff(overlap_range)) {
-                        edges_.insert(remain);
-                    }
-                }
+            edges_.insert(compute_edges());
+        } else if (!dirty_.empty()) {
+            for (U64 i = 0; i < dirty_.size(); ++i) {
+                update_edges(dirty_[i]);
             }
+            dirty_.clear();
         }
         return edges_;
     }
 
+    const List<Edge> &get_surface() const {
+        if (surface_changed_) {
+            surface_changed_ = false;
+            surface_ = compute_surface();
+        }
+        return surface_;
+    }
+
+    /// Returns true if the current edges cover exactly the same faces as a full rebuild.
+    /// Incremental updates can split edges differently than a rebuild, so this compares coverage, not edges.
+    pure bool check_edges() const {
+        const EdgeTree &edges = get_edges();
+        EdgeTree expected;
+        expected.insert(compute_edges());
+        return covers(edges, expected) && covers(expected, edges);
+    }
+
     ItemTree items_;
 
 private:
+    /// Returns the remaining parts of [edge] after removing all item volumes.
+    void add_remaining(List<Edge> &result, const Edge &edge) const {
+        List<Box<N>> overlap;
+        items_.for_each_in(edge.bbox(), [&](const ItemRef &b) { overlap.push_back(bbox(b)); });
+        Range<Box<N>> overlap_range = overlap.range();
+        for (const Edge &remain : edge.diff(overlap_range)) {
+            result.push_back(remain);
+        }
+    }
+
+    /// Computes all edges across all items.
+    pure List<Edge> compute_edges() const {
+        List<Edge> edges;
+        for (const ItemRef &item : items_.items()) {
+            for (const auto &edge : bbox(item).edges()) {
+                add_remaining(edges, edge);
+            }
+        }
+        return edges;
+    }
+
+    /// Recomputes the edges within [region] from the current items.
+    /// Adding or removing an item only changes edges directly adjacent to it or overlapping it, so updating the
+    /// item's bounds widened by 1 matches a full rebuild. Edges crossing the border of [region] are split.
+    void update_edges(const Box<N> &region) const {
+        List<EdgeRef> stale;
+        edges_.for_each_in(region, [&](const EdgeRef &edge) { stale.push_back(edge); });
+        List<Edge> edges;
+        for (const EdgeRef &edge : stale) {
+            edges.append(edge->diff(region));
+        }
+        edges_.remove(stale);
+
+        // Only items within 1 of the region can have edges inside of it
+        items_.for_each_in(Box<N>(region.min - 1, region.end + 1), [&](const ItemRef &item) {
+            for (const auto &edge : bbox(item).edges()) {
+                if (const auto clipped = edge.box.intersect(region)) {
+                    add_remaining(edges, Edge(edge.dir, edge.dim, *clipped));
+                }
+            }
+        });
+        edges_.insert(edges);
+    }
+
+    /// Computes the surface from the current edges, merging coplanar faces greedily.
+    /// e.g. a floor made of a grid of parts becomes a single face on each side.
+    pure List<Edge> compute_surface() const {
+        List<Edge> faces;
+        for (const EdgeRef &edge : get_edges().items()) {
+            // Edges are just outside of the items; faces are the zero-thickness boundary between the two
+            const I64 plane = edge->dir == Dir::Neg ? edge->box.end[edge->dim] : edge->box.min[edge->dim];
+            const Box<N> face(edge->box.min.with(edge->dim, plane), edge->box.end.with(edge->dim, plane));
+            faces.emplace_back(edge->dir, edge->dim, face);
+        }
+        // Faces on the same plane are only merged if they face the same way
+        return merge_adjacent<N>(std::move(faces), [](const Edge &face) {
+            return std::make_pair(face.dim, face.dir == Dir::Neg ? 0 : 1);
+        });
+    }
+
+    /// Returns true if each edge in [a] is entirely covered by edges in [b] with the same face.
+    pure static bool covers(const EdgeTree &a, const EdgeTree &b) {
+        for (const EdgeRef &edge : a.items()) {
+            List<Box<N>> same;
+            b.for_each_in(edge->box, [&](const EdgeRef &other) {
+                if (other->face() == edge->face()) {
+                    same.push_back(other->box);
+                }
+            });
+            return_if(!edge->box.diff(same).empty(), false);
+        }
+        return true;
+    }
+
     mutable bool changed_ = false;
+    mutable List<Box<N>> dirty_; // Regions where edges must be recomputed
     mutable EdgeTree edges_;
+    mutable bool surface_changed_ = true;
+    mutable List<Edge> surface_; // Merged faces of the surface, cached until the items next change
 };
 
 } // namespace detail
@@ -97,7 +200,7 @@ public:
 
     ItemRef insert(const Item &item) {
         auto ref = this->items_.insert(item);
-        this->mark_changed();
+        this->mark_changed(Parent::bbox(ref));
         return ref;
     }
 
@@ -110,16 +213,60 @@ public:
     template <typename T = Item, typename... Args>
     ItemRef emplace(Args &&...args) {
         auto ref = this->items_.template emplace<T>(std::forward<Args>(args)...);
-        this->mark_changed();
+        this->mark_changed(Parent::bbox(ref));
         return ref;
     }
 
+    /// Removes all items from this tree.
+    BRTree &clear() {
+        this->items_.clear();
+        this->mark_changed();
+        return *this;
+    }
+
     BRTree &remove(const ItemRef item) {
+        const Box<N> box = Parent::bbox(item);
         this->items_.remove(item);
-        this->mark_changed();
+        this->mark_changed(box);
+        return *this;
+    }
+    BRTree &remove(const Range<ItemRef> &items) {
+        for (const ItemRef &item : items) {
+            this->mark_changed(Parent::bbox(item));
+        }
+        this->items_.remove(items);
         return *this;
     }
 
+    /// Calls [func] on each stored item in the given volume, visiting each item exactly once.
+    /// Stops early if [func] returns WalkResult::kExit.
+    template <typename VisitFunc> // ItemRef => WalkResult | void
+    expand void for_each_in(const Box<N> &box, VisitFunc func) const {
+        this->items_.for_each_in(box - loc, func);
+    }
+    template <typename VisitFunc> // ItemRef => WalkResult | void
+    expand void for_each_in(const Pos<N> &pos, VisitFunc func) const {
+        this->items_.for_each_in(pos - loc, func);
+    }
+
+    /// Returns true if any stored item in the given volume meets the condition [cond].
+    template <typename Cond> // ItemRef => bool
+    pure expand bool any_in(const Box<N> &box, Cond cond) const {
+        return this->items_.any_in(box - loc, cond);
+    }
+    template <typename Cond> // ItemRef => bool
+    pure expand bool any_in(const Pos<N> &pos, Cond cond) const {
+        return this->items_.any_in(pos - loc, cond);
+    }
+
+    /// Returns up to [k] items nearest to [pos], ordered by increasing distance.
+    pure expand List<ItemRef> nearest(const Pos<N> &pos, const U64 k) const { return this->items_.nearest(pos - loc, k); }
+
+    /// Returns all items within [radius] of [pos], ordered by increasing distance.
+    pure expand List<ItemRef> within(const Pos<N> &pos, const F64 radius) const {
+        return this->items_.within(pos - loc, radius);
+    }
+
     /// Returns a set of all stored items in the given volume.
     pure expand Set<ItemRef> operator[](const Box<N> &box) const { return this->items_[box - loc]; }
     pure expand Set<ItemRef> operator[](const Pos<N> &pos) const { return this->items_[pos - loc]; }
@@ -146,6 +293,14 @@ public:
     pure Range<ItemRef> items() const { return this->items_.items(); }
     pure Range<EdgeRef> edges() const { return edge_rtree().items(); }
 
+    /// Returns the faces on the outside of all items, with adjacent coplanar faces merged into larger faces.
+    /// Faces have a thickness of zero and are relative to loc, so moving the tree does not change them.
+    /// Computed from the edges and cached until items are next added or removed.
+    pure const List<Edge> &surface() const { return this->get_surface(); }
+
+    /// Returns true if the incrementally maintained edges match a full rebuild. For testing and debugging only.
+    pure bool check_edges() const { return Parent::check_edges(); }
+
     pure List<Set<ItemRef>> components() const { return this->items_.components(); }
 
     /// Returns the bounding box over all values in this tree.
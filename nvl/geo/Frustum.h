@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "nvl/geo/Tuple.h"
+#include "nvl/geo/Volume.h"
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Pure.h"
+#include "nvl/macros/ReturnIf.h"
+#include "nvl/math/Deg.h"
+
+namespace nvl {
+
+/**
+ * @class Frustum
+ * @brief The volume visible from a perspective camera, bounded by a near and far plane and the four view sides.
+ *
+ * Represented as the intersection of six inward-facing half spaces. Overlap tests against boxes are conservative:
+ * a box which is outside of the frustum but not entirely outside of any one plane may still be reported as
+ * overlapping, but a box which overlaps the frustum is never reported as outside.
+ */
+class Frustum {
+public:
+    /// The half space of points p where dot(normal, p) + offset >= 0.
+    struct HalfSpace {
+        Vec<3> normal;
+        F64 offset;
+
+        /// Returns the signed distance from [pt] to this plane, scaled by the length of the normal.
+        pure F64 dist(const Vec<3> &pt) const { return dot(normal, pt) + offset; }
+    };
+
+    /**
+     * Creates the frustum for a camera at [eye] looking along [forward] with the screen's vertical axis along [up].
+     * @param fovy - Vertical field of view, in degrees.
+     * @param aspect - Width over height of the screen.
+     * @param near - Distance from the eye to the near plane.
+     * @param far - Distance from the eye to the far plane.
+     */
+    Frustum(const Vec<3> &eye, const Vec<3> &forward, const Vec<3> &up, const F64 fovy, const F64 aspect,
+            const F64 near, const F64 far) {
+        const Vec<3> f = forward / forward.magnitude();
+        const Vec<3> r = normalized(cross(f, up));
+        const Vec<3> u = cross(r, f);
+        const F64 tan_y = std::tan(fovy * kDeg2Rad / 2);
+        const F64 tan_x = tan_y * aspect;
+        planes_[0] = through(eye + f * near, f);
+        planes_[1] = through(eye + f * far, -f);
+        // Side planes pass through the eye and lean outwards by the half field of view
+        planes_[2] = through(eye, r + f * tan_x);
+        planes_[3] = through(eye, -r + f * tan_x);
+        planes_[4] = through(eye, u + f * tan_y);
+        planes_[5] = through(eye, -u + f * tan_y);
+    }
+
+    /// Returns a copy of this frustum shifted by -[x].
+    template <typename T>
+    pure Frustum operator-(const Tuple<3, T> &x) const {
+        Frustum result = *this;
+        const Vec<3> shift = real(x);
+        for (HalfSpace &plane : result.planes_) {
+            plane.offset += dot(plane.normal, shift);
+        }
+        return result;
+    }
+
+    /// Returns true if the point [pt] is within this frustum.
+    pure bool contains(const Vec<3> &pt) const {
+        for (const HalfSpace &plane : planes_) {
+            return_if(plane.dist(pt) < 0, false);
+        }
+        return true;
+    }
+
+    /// Returns true if [box] may overlap this frustum, i.e. if it is not entirely outside of any one plane.
+    pure bool overlaps(const Box<3> &box) const {
+        for (const HalfSpace &plane : planes_) {
+            // The corner of the box furthest along the normal is the last to leave the half space
+            Vec<3> corner;
+            for (U64 i = 0; i < 3; ++i) {
+                corner[i] = static_cast<F64>(plane.normal[i] >= 0 ? box.end[i] : box.min[i]);
+            }
+            return_if(plane.dist(corner) < 0, false);
+        }
+        return true;
+    }
+
+    pure const std::array<HalfSpace, 6> &half_spaces() const { return planes_; }
+
+private:
+    pure static F64 dot(const Vec<3> &a, const Vec<3> &b) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+    pure static Vec<3> cross(const Vec<3> &a, const Vec<3> &b) {
+        return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+    }
+    pure static Vec<3> normalized(const Vec<3> &a) { return a / a.magnitude(); }
+
+    /// Returns the plane through [pt] facing along [normal].
+    pure static HalfSpace through(const Vec<3> &pt, const Vec<3> &normal) { return {normal, -dot(normal, pt)}; }
+
+    std::array<HalfSpace, 6> planes_; // Near, far, then the left, right, bottom, and top sides
+};
+
+} // namespace nvl
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <limits>
+
 #include "nvl/data/WalkResult.h"
 #include "nvl/geo/Face.h"
 #include "nvl/geo/Line.h"
@@ -57,6 +59,66 @@ pure Maybe<Intersect<N>> intersect(const AbstractLine<N, Concrete> &line, const
     return None;
 }
 
+/// Returns the distances from the line's [a] at which the line segment enters and exits the given box, using the
+/// slab method. The box is treated as closed, so this is a conservative bound for boxes with exclusive ends.
+/// Returns None if the line segment does not pass through the box.
+template <U64 N, typename T, typename Concrete>
+pure Maybe<std::pair<F64, F64>> clip(const AbstractLine<N, Concrete> &line, const Volume<N, T> &box) {
+    const Vec<N> &a = line.a();
+    const Vec<N> &b = line.b();
+    const F64 len = line.length();
+    F64 enter = 0;
+    F64 exit = len;
+    for (U64 i = 0; i < N; ++i) {
+        const F64 lo = static_cast<F64>(box.min[i]);
+        const F64 hi = static_cast<F64>(box.end[i]);
+        if (a[i] == b[i]) {
+            return_if(a[i] < lo || a[i] > hi, None);
+        } else {
+            const F64 scale = len / (b[i] - a[i]);
+            const F64 t0 = (lo - a[i]) * scale;
+            const F64 t1 = (hi - a[i]) * scale;
+            enter = std::max(enter, std::min(t0, t1));
+            exit = std::min(exit, std::max(t0, t1));
+            return_if(enter > exit, None);
+        }
+    }
+    return std::pair<F64, F64>{enter, exit};
+}
+
+/// First contact between a box moving along a displacement and a fixed box.
+struct Impact {
+    F64 time = 0; // Fraction of the displacement travelled before contact, in [0, 1)
+    Face face;    // Face of the moving box which makes contact
+    I64 gap = 0;  // Distance which can be travelled along the face's dimension before contact
+};
+
+/// Returns the first contact between [box] moving along [delta] and the fixed box [other], using the swept-AABB
+/// slab test over all dimensions at once. Boxes which only touch do not collide.
+/// Returns None if the boxes do not come into contact along the path or already overlap at the start.
+template <U64 N>
+pure Maybe<Impact> sweep(const Box<N> &box, const Pos<N> &delta, const Box<N> &other) {
+    Impact impact{.time = -std::numeric_limits<F64>::infinity()};
+    F64 exit = std::numeric_limits<F64>::infinity();
+    for (U64 i = 0; i < N; ++i) {
+        if (delta[i] == 0) {
+            return_if(box.end[i] <= other.min[i] || other.end[i] <= box.min[i], None);
+        } else {
+            const bool pos = delta[i] > 0;
+            const I64 gap_in = pos ? other.min[i] - box.end[i] : other.end[i] - box.min[i];
+            const I64 gap_out = pos ? other.end[i] - box.min[i] : other.min[i] - box.end[i];
+            const F64 t_in = static_cast<F64>(gap_in) / static_cast<F64>(delta[i]);
+            const F64 t_out = static_cast<F64>(gap_out) / static_cast<F64>(delta[i]);
+            if (t_in > impact.time) {
+                impact = Impact{.time = t_in, .face = Face(pos ? Dir::Pos : Dir::Neg, i), .gap = gap_in};
+            }
+            exit = std::min(exit, t_out);
+        }
+    }
+    return_if(impact.time < 0 || impact.time >= 1 || impact.time >= exit, None);
+    return impact;
+}
+
 /// Returns true if this line segment intersects the given box.
 template <U64 N, typename T, typename Concrete>
 pure bool intersects(const AbstractLine<N, Concrete> &line, const Volume<N, T> &box) {
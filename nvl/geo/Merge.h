@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "nvl/data/List.h"
+#include "nvl/geo/Volume.h"
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Pure.h"
+
+namespace nvl {
+
+/**
+ * Greedily merges values with a `box` member which are adjacent along each axis in turn and identical in every other
+ * axis. For example, a grid of unit boxes first becomes one box per row, then the rows become a single box.
+ *
+ * The result covers exactly the same volume as [values], but is not guaranteed to be the fewest possible boxes.
+ * Takes O(N * V log V) time for V values.
+ *
+ * @tparam N - Number of dimensions.
+ * @param values - The values to merge. Boxes should not overlap.
+ * @param group - Returns a key for each value. Only values with equal keys are merged. Keys must be ordered.
+ * @return The merged values. Merged values keep the other members of the first value along each axis.
+ */
+template <U64 N, typename Value, typename Group> // Value => Key
+pure List<Value> merge_adjacent(List<Value> values, Group group) {
+    for (U64 axis = 0; axis < N; ++axis) {
+        // Orders values by group, then by their extent in every axis except [axis], then along [axis]
+        const auto key = [&](const Value &value) {
+            std::array<I64, 2 * N> extents;
+            U64 i = 0;
+            for (U64 d = 0; d < N; ++d) {
+                if (d != axis) {
+                    extents[i++] = value.box.min[d];
+                    extents[i++] = value.box.end[d];
+                }
+            }
+            extents[i++] = value.box.min[axis];
+            extents[i++] = value.box.end[axis];
+            return std::make_pair(group(value), extents);
+        };
+        std::sort(values.begin(), values.end(), [&](const Value &a, const Value &b) { return key(a) < key(b); });
+
+        List<Value> merged;
+        for (const Value &value : values) {
+            Value *last = merged.empty() ? nullptr : &merged.back();
+            // Boxes with no thickness along [axis] (e.g. faces) are never merged along it
+            const bool adjacent = last && last->box.end[axis] == value.box.min[axis] &&
+                                  last->box.min[axis] != last->box.end[axis] &&
+                                  value.box.min[axis] != value.box.end[axis] &&
+                                  last->box.min.with(axis, 0) == value.box.min.with(axis, 0) &&
+                                  last->box.end.with(axis, 0) == value.box.end.with(axis, 0) &&
+                                  group(*last) == group(value);
+            if (adjacent) {
+                last->box.end[axis] = value.box.end[axis];
+            } else {
+                merged.push_back(value);
+            }
+        }
+        values = std::move(merged);
+    }
+    return values;
+}
+
+} // namespace nvl
@@ -1,13 +1,22 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
+#include <queue>
+#include <span>
+#include <utility>
 
+#include "nvl/data/DenseUnionFind.h"
+#include "nvl/data/FlatMap.h"
+#include "nvl/data/IterRange.h"
 #include "nvl/data/List.h"
 #include "nvl/data/Map.h"
+#include "nvl/data/Pool.h"
 #include "nvl/data/Range.h"
 #include "nvl/data/Ref.h"
 #include "nvl/data/Set.h"
-#include "nvl/data/UnionFind.h"
 #include "nvl/data/WalkResult.h"
 #include "nvl/geo/HasBBox.h"
 #include "nvl/geo/Intersect.h"
@@ -19,21 +28,117 @@
 #include "nvl/macros/Aliases.h"
 #include "nvl/macros/Hot.h"
 #include "nvl/macros/ReturnIf.h"
+#include "nvl/macros/SIMD.h"
 #include "nvl/math/Bitwise.h"
 
 namespace nvl {
 
 namespace detail {
 
+/// Location of an item within the list of a node.
+struct Slot {
+    U32 node;  // Id of the node holding the item
+    U32 index; // Index of the item within the node's list
+};
+
+/// Bookkeeping for each item held in an RTree.
+struct Entry {
+    U64 id = 0;       // Key of the item in the tree's item map
+    List<Slot> slots; // Every node which currently holds this item
+};
+
+/**
+ * @class BoxList
+ * @brief Bounding boxes of the items held by a node, stored as one array per bound and dimension.
+ * Overlap tests against a query box run over these contiguous arrays without dereferencing the items themselves.
+ */
+template <U64 N>
+struct BoxList {
+    static constexpr U64 kChunk = 64; // Maximum number of boxes tested in one call to overlaps
+
+    pure U64 size() const { return min[0].size(); }
+
+    pure Box<N> operator[](const U64 i) const {
+        Box<N> box;
+        for (U64 d = 0; d < N; ++d) {
+            box.min[d] = min[d][i];
+            box.end[d] = end[d][i];
+        }
+        return box;
+    }
+
+    void push_back(const Box<N> &box) {
+        for (U64 d = 0; d < N; ++d) {
+            min[d].push_back(box.min[d]);
+            end[d].push_back(box.end[d]);
+        }
+    }
+
+    void set(const U64 i, const Box<N> &box) {
+        for (U64 d = 0; d < N; ++d) {
+            min[d][i] = box.min[d];
+            end[d][i] = box.end[d];
+        }
+    }
+
+    void pop_back() {
+        for (U64 d = 0; d < N; ++d) {
+            min[d].pop_back();
+            end[d].pop_back();
+        }
+    }
+
+    void resize(const U64 size) {
+        for (U64 d = 0; d < N; ++d) {
+            min[d].resize(size);
+            end[d].resize(size);
+        }
+    }
+
+    void reserve(const U64 size) {
+        for (U64 d = 0; d < N; ++d) {
+            min[d].reserve(size);
+            end[d].reserve(size);
+        }
+    }
+
+    void clear() { resize(0); }
+
+    /// Sets mask[k] to true if the box at index [begin] + k overlaps [box], for each k in [0, n).
+    /// [n] must be at most kChunk, and [begin] + [n] at most the number of boxes.
+    void overlaps(const Box<N> &box, const U64 begin, const U64 n, bool *mask) const {
+        const I64 *lo[N];
+        const I64 *hi[N];
+        for (U64 d = 0; d < N; ++d) {
+            lo[d] = &*(min[d].begin() + begin);
+            hi[d] = &*(end[d].begin() + begin);
+        }
+        simd for (U64 k = 0; k < n; ++k) {
+            bool hit = true;
+            for (U64 d = 0; d < N; ++d) {
+                hit = hit & (lo[d][k] < box.end[d]) & (box.min[d] < hi[d][k]);
+            }
+            mask[k] = hit;
+        }
+    }
+
+    std::array<List<I64>, N> min;
+    std::array<List<I64>, N> end;
+};
+
 /**
  * @class Node
  * @brief A node within an RTree.
+ * Nodes are stored in a Pool owned by the tree and refer to their parent and children by index.
  */
 template <U64 N, typename ItemRef>
 struct Node : Orthants<N> {
-    static constexpr U64 E = 1 << N; // Number of orthants, i.e. 2^N
+    static constexpr U64 E = 1 << N;                                // Number of orthants, i.e. 2^N
+    static constexpr U32 kNone = std::numeric_limits<U32>::max(); // Index of a missing parent or child
+    static constexpr U32 kRoot = 0;                                 // Index of the root node (the tree itself)
 
-    Node(Node *parent, const U64 id, const Pos<N> &origin, const I64 grid_size)
+    Node() : Orthants<N>(Pos<N>::fill(0), 0) {}
+    Node(const U32 parent, const U32 id, const Pos<N> &origin, const I64 grid_size)
         : Orthants<N>(origin, grid_size), parent(parent), id(id) {}
 
     Node(const Node &) = delete;
@@ -42,94 +147,77 @@ struct Node : Orthants<N> {
     pure bool operator==(const Node &rhs) const { return id == rhs.id; }
     pure bool operator!=(const Node &rhs) const { return !(*this == rhs); }
 
-    pure Node *get(const Pos<N> &pos) const {
-        const auto index = get_index(pos);
-        return index ? children[*index] : nullptr;
+    /// Reinitializes a recycled node. Keeps the capacity of the item list.
+    void reset(const U32 parent_id, const U32 node_id, const Pos<N> &origin, const I64 grid_size) {
+        this->origin = origin;
+        this->grid_size = grid_size;
+        parent = parent_id;
+        id = node_id;
+        list.clear();
+        entries.clear();
+        boxes.clear();
+        children = Tuple<E, U32>::fill(kNone);
     }
 
-    void remove_child(Node *child) {
-        simd for (U64 i = 0; i < E; ++i) { children[i] = children[i] == child ? nullptr : children[i]; }
+    void reserve(const U64 size) {
+        list.reserve(size);
+        entries.reserve(size);
+        boxes.reserve(size);
+    }
+
+    void remove_child(const U32 child) {
+        simd for (U64 i = 0; i < E; ++i) { children[i] = children[i] == child ? kNone : children[i]; }
     }
 
     pure bool has_child() const {
         for (U64 i = 0; i < E; ++i) {
-            return_if(children[i] != nullptr, true);
+            return_if(children[i] != kNone, true);
         }
         return false;
     }
 
     pure bool empty() const { return !has_child() && list.empty(); }
 
-    pure U64 depth() const {
-        U64 depth = 0;
-        Node *node = parent;
-        while (node) {
-            node = node->parent;
-            depth += 1;
-        }
-        return depth;
-    }
-
-    Node *parent;
-    U64 id;
-    List<ItemRef> list;
-    Tuple<E, Node *> children = Tuple<E, Node *>::fill(nullptr);
-};
-
-template <U64 N, typename ItemRef, typename VisitFunc> // Node* => WalkResult
-void unconditional_preorder_walk_nodes_in(const Node<N, ItemRef> *top, const Box<N> &box, VisitFunc func) {
-    List<const Node<N, ItemRef> *> frontier;
-    if (top->bbox().overlaps(box))
-        frontier.push_back(top);
-    while (!frontier.empty()) {
-        const Node<N, ItemRef> *current = frontier.back();
-        frontier.pop_back();
-        func(current);
-        for (const Node<N, ItemRef> *child : current->children) {
-            if (child && box.overlaps(child->bbox())) {
-                frontier.push_back(child);
+    /// Calls [func] on the index of each item in this node which overlaps [box], in order.
+    /// Stops early and returns WalkResult::kExit if [func] returns WalkResult::kExit.
+    template <typename Func> // U64 => WalkResult
+    WalkResult for_each_overlapping(const Box<N> &box, Func func) const {
+        bool mask[BoxList<N>::kChunk];
+        for (U64 begin = 0; begin < list.size(); begin += BoxList<N>::kChunk) {
+            const U64 n = std::min(BoxList<N>::kChunk, list.size() - begin);
+            boxes.overlaps(box, begin, n, mask);
+            for (U64 k = 0; k < n; ++k) {
+                if (mask[k]) {
+                    return_if(func(begin + k) == WalkResult::kExit, WalkResult::kExit);
+                }
             }
         }
+        return WalkResult::kRecurse;
     }
-}
 
-template <U64 N, typename ItemRef, typename VisitFunc> // Node* => WalkResult
-void preorder_walk_nodes_in(const Node<N, ItemRef> *top, const Box<N> &box, VisitFunc func) {
-    List<const Node<N, ItemRef> *> frontier;
-    if (top->bbox().overlaps(box))
-        frontier.push_back(top);
-    while (!frontier.empty()) {
-        const Node<N, ItemRef> *current = frontier.back();
-        frontier.pop_back();
-        const WalkResult result = func(current);
-        return_if(result == WalkResult::kExit);
-        if (result == WalkResult::kRecurse) {
-            for (const Node<N, ItemRef> *child : current->children) {
-                if (child && box.overlaps(child->bbox())) {
-                    frontier.push_back(child);
-                }
-            }
-        }
+    /// Items which span multiple nodes are stored in each of them. Returns true if this is the single node which
+    /// should report an item with bounds [item_box] for a query over [box], i.e. the node which contains the minimum
+    /// corner of their overlap. Assumes the two boxes overlap.
+    pure bool owns(const Box<N> &item_box, const Box<N> &box) const {
+        return this->bbox().contains(nvl::max(item_box.min, box.min));
     }
-}
 
-template <U64 N, typename ItemRef, typename VisitFunc> // Node* => WalkResult
-void preorder_walk_nodes_in(Node<N, ItemRef> *top, const Box<N> &box, VisitFunc func) {
-    List<Node<N, ItemRef> *> frontier;
-    if (top->bbox().overlaps(box))
-        frontier.push_back(top);
-    while (!frontier.empty()) {
-        Node<N, ItemRef> *current = frontier.back();
-        frontier.pop_back();
-        const WalkResult result = func(current);
-        return_if(result == WalkResult::kExit);
-        if (result == WalkResult::kRecurse) {
-            for (Node<N, ItemRef> *child : current->children) {
-                if (child && box.overlaps(child->bbox())) {
-                    frontier.push_back(child);
-                }
-            }
-        }
+    U32 parent = kNone;
+    U32 id = kRoot;
+    List<ItemRef> list;
+    List<Entry *> entries; // Entry for each item in list, kept in the same order
+    BoxList<N> boxes;      // Bounding box of each item in list, kept in the same order
+    Tuple<E, U32> children = Tuple<E, U32>::fill(kNone);
+};
+
+/// Calls [func] on [item], converting a void result to WalkResult::kRecurse.
+template <typename ItemRef, typename VisitFunc> // ItemRef => WalkResult | void
+expand WalkResult visit_item(const ItemRef &item, VisitFunc &func) {
+    if constexpr (std::is_void_v<std::invoke_result_t<VisitFunc &, const ItemRef &>>) {
+        func(item);
+        return WalkResult::kRecurse;
+    } else {
+        return func(item);
     }
 }
 
@@ -160,45 +248,55 @@ public:
     };
 
     /// Allows iteration over all elements in the tree, viewing them as ItemRef (type wrapper).
-    struct item_iterator final : AbstractIteratorCRTP<item_iterator, ItemRef> {
-        class_tag(item_iterator, AbstractIterator<ItemRef>);
-        using ItemMap = Map<U64, std::unique_ptr<Item>>;
-
-        template <View Type = View::kImmutable>
-        pure static Iterator<ItemRef, Type> begin(const ItemMap &map) {
-            return make_iterator<item_iterator, Type>(map.values_begin());
-        }
-        template <View Type = View::kImmutable>
-        pure static Iterator<ItemRef, Type> end(const ItemMap &map) {
-            return make_iterator<item_iterator, Type>(map.values_end());
+    struct item_iterator {
+        using ItemMap = FlatMap<U64, std::unique_ptr<Item>>;
+        using value_type = ItemRef;
+        using difference_type = std::ptrdiff_t;
+        using reference = const ItemRef &;
+        using pointer = const ItemRef *;
+        using iterator_category = std::forward_iterator_tag;
+
+        item_iterator() = default;
+        explicit item_iterator(ItemMap::const_iterator iter) : iter(iter) {}
+
+        item_iterator &operator++() {
+            ++iter;
+            return *this;
         }
-
-        explicit item_iterator(Iterator<std::unique_ptr<Item>> iter) : iter(iter) {}
-
-        void increment() override {
-            item = None;
+        item_iterator operator++(int) {
+            item_iterator prev = *this;
             ++iter;
+            return prev;
         }
 
-        pure const ItemRef *ptr() override {
-            if (!item.has_value()) {
-                // Lazily set the item on dereference to avoid dereferencing an empty iterator
-                item = ItemRef(iter->get());
-            }
-            return &item.value();
+        pure reference operator*() const {
+            // Set the item on dereference to avoid dereferencing an empty iterator
+            item = ItemRef(iter->second.get());
+            return item.value();
         }
+        pure pointer operator->() const { return &**this; }
 
-        pure bool operator==(const item_iterator &rhs) const override { return iter == rhs.iter; }
+        pure bool operator==(const item_iterator &rhs) const { return iter == rhs.iter; }
 
     private:
-        Maybe<ItemRef> item = None;
-        Iterator<std::unique_ptr<Item>> iter;
+        mutable Maybe<ItemRef> item = None;
+        ItemMap::const_iterator iter;
     };
 
+    /// Returns true if boxes [a] and [b] overlap or share part of a face.
+    pure static bool connected(const Box<N> &a, const Box<N> &b) {
+        U64 touching = 0;
+        for (U64 i = 0; i < N; ++i) {
+            return_if(a.min[i] > b.end[i] || b.min[i] > a.end[i], false);
+            touching += (a.min[i] == b.end[i] || b.min[i] == a.end[i]) ? 1 : 0;
+        }
+        return touching <= 1;
+    }
+
     // TODO: Need to formalize this better, rely just on HasBBox here.
     expand static Box<N> bbox(const ItemRef &item) { return static_cast<const Item *>(item.ptr())->bbox(); }
 
-    RTree() : Node(nullptr, 0, Pos<N>::fill(0), kGridExpMin) {}
+    RTree() : Node(Node::kNone, Node::kRoot, Pos<N>::fill(0), kGridExpMin) {}
 
     RTree(std::initializer_list<Item> items) : RTree() {
         for (const auto &item : items) {
@@ -217,18 +315,34 @@ public:
 
     /// Inserts a copy of the item into the tree.
     /// Returns a reference to the copy held by the tree.
+    /// Nodes filter queries by the item's bounding box at the time it was added, so callers must call move() after
+    /// any change to an item's bounding box, including when it only shrinks.
     ItemRef insert(const Item &item) { return insert_over(item); }
     ItemRef insert(const ItemRef &item) { return insert_over(*item); }
 
     /// Inserts a copy of each item into the tree.
+    /// Items are bulk loaded: the root grid is resized once for all items, and the hierarchy is then built top-down
+    /// in a single pass rather than rebalancing after each individual insertion.
     RTree &insert(const Range<Item> &items) {
-        for (const Item &item : items)
-            insert_over(item);
+        List<ItemRef> refs;
+        List<Entry *> entries;
+        for (const Item &item : items) {
+            const auto [ref, entry] = store(std::make_unique<Item>(item));
+            refs.push_back(ref);
+            entries.push_back(entry);
+        }
+        add_and_balance(refs, entries);
         return *this;
     }
     RTree &insert(const Range<ItemRef> &items) {
-        for (const ItemRef &item : items)
-            insert_over(item.raw());
+        List<ItemRef> refs;
+        List<Entry *> entries;
+        for (const ItemRef &item : items) {
+            const auto [ref, entry] = store(std::make_unique<Item>(item.raw()));
+            refs.push_back(ref);
+            entries.push_back(entry);
+        }
+        add_and_balance(refs, entries);
         return *this;
     }
 
@@ -242,36 +356,98 @@ public:
     }
 
     /// Removes the matching item from the tree, if it exists.
-    RTree &remove(const ItemRef &item) { return remove_over(item, bbox(item), true); }
+    /// If the item was on the boundary of the tree, the bounds are only marked as stale: the bounding box is
+    /// recomputed by the next call to bbox(), and the root grid is shrunk by the next insertion, move, or compact().
+    RTree &remove(const ItemRef &item) {
+        remove_over(item);
+        return *this;
+    }
+    /// Removes all matching items from the tree, then compacts the tree once if any were on its boundary.
     RTree &remove(Range<ItemRef> items) {
         for (const ItemRef &item : items)
-            remove_over(item, bbox(item), true);
+            remove_over(item);
+        if (stale_grid_) {
+            compact();
+        }
         return *this;
     }
 
     /// Registers the matching item as having moved from the previous volume `prev` to its current volume.
+    /// Must be called after any change to the item's bounding box, since nodes otherwise keep its previous box.
     /// Does nothing if no matching item exists in the tree.
-    RTree &move(const ItemRef &item, const Box<N> &prev) { return move_from(item, prev); }
+    /// Each item records which nodes hold it, so removal from its previous nodes does not depend on `prev`.
+    RTree &move(const ItemRef &item, const Box<N> &) { return move_from(item); }
 
     /// Calls [func] on all existing nodes in the given volume. Traversal is depth-first preorder.
     template <typename VisitFunc> // Node* => WalkResult
     expand void preorder_walk_nodes(VisitFunc func) const {
-        detail::preorder_walk_nodes_in(this, bbox_, func);
+        walk_nodes_in(*this, bbox_, func);
     }
 
     template <typename VisitFunc> // Node* => WalkResult
     expand void preorder_walk_nodes_in(const Box<N> &box, VisitFunc func) const {
-        detail::preorder_walk_nodes_in(this, box, func);
+        walk_nodes_in(*this, box, func);
     }
 
     template <typename VisitFunc> // Node* => WalkResult
     expand void preorder_walk_nodes(VisitFunc func) {
-        detail::preorder_walk_nodes_in(this, bbox_, func);
+        walk_nodes_in(*this, bbox_, func);
     }
 
     template <typename VisitFunc> // Node* => WalkResult
     expand void preorder_walk_nodes_in(const Box<N> &box, VisitFunc func) {
-        detail::preorder_walk_nodes_in(this, box, func);
+        walk_nodes_in(*this, box, func);
+    }
+
+    /// Calls [func] on each stored item in the given volume, visiting each item exactly once.
+    /// Stops early if [func] returns WalkResult::kExit. Does not allocate.
+    template <typename VisitFunc> // ItemRef => WalkResult | void
+    void for_each_in(const Box<N> &box, VisitFunc func) const {
+        return_if(!bbox().overlaps(box));
+        preorder_walk_nodes_in(box, [&](const Node *node) {
+            return node->for_each_overlapping(box, [&](const U64 i) {
+                return_if(!node->owns(node->boxes[i], box), WalkResult::kRecurse);
+                return detail::visit_item(node->list[i], func);
+            });
+        });
+    }
+    template <typename VisitFunc> // ItemRef => WalkResult | void
+    expand void for_each_in(const Pos<N> &pos, VisitFunc func) const {
+        for_each_in(Box<N>::unit(pos), func);
+    }
+
+    /// Calls [func] on each stored item which overlaps [shape], visiting each item exactly once.
+    /// [shape] may be any volume with an `overlaps(const Box<N> &)` test which is never false for a box it overlaps,
+    /// e.g. a Frustum. Nodes outside of [shape] are skipped along with all of their children.
+    /// Stops early if [func] returns WalkResult::kExit. Does not allocate.
+    template <typename Shape, typename VisitFunc> // ItemRef => WalkResult | void
+    void for_each_overlapping(const Shape &shape, VisitFunc func) const {
+        auto visit_node = [&](const Node *node) {
+            for (U64 i = 0; i < node->list.size(); ++i) {
+                const ItemRef &item = node->list[i];
+                if (shape.overlaps(node->boxes[i]) && owner(*node->entries[i], shape) == node->id) {
+                    return_if(detail::visit_item(item, func) == WalkResult::kExit, WalkResult::kExit);
+                }
+            }
+            return WalkResult::kRecurse;
+        };
+        walk_nodes_in(*this, shape, visit_node);
+    }
+
+    /// Returns true if any stored item in the given volume meets the condition [cond].
+    /// Stops at the first matching item. Does not allocate.
+    template <typename Cond> // ItemRef => bool
+    pure bool any_in(const Box<N> &box, Cond cond) const {
+        bool found = false;
+        for_each_in(box, [&](const ItemRef &item) {
+            found = cond(item);
+            return found ? WalkResult::kExit : WalkResult::kRecurse;
+        });
+        return found;
+    }
+    template <typename Cond> // ItemRef => bool
+    pure expand bool any_in(const Pos<N> &pos, Cond cond) const {
+        return any_in(Box<N>::unit(pos), cond);
     }
 
     /// Returns a set of all stored items in the given volume.
@@ -284,8 +460,81 @@ public:
 
     /// Returns the closest item which intersects with the line segment.
     /// Also returns the location and face of the intersection, if it exists.
-    pure expand Maybe<Intersect> first(const Line<N> &line) const {
-        return first_where(line, [](const Intersect &intersect) { return intersect.dist; });
+    pure Maybe<Intersect> first(const Line<N> &line) const {
+        Maybe<Intersect> closest = None;
+        walk_along(line, [&](const ItemRef &item) -> Maybe<F64> {
+            auto intersection = intersect(line, bbox(item));
+            return_if(!intersection.has_value(), None);
+            if (!closest.has_value() || intersection->dist < closest->dist) {
+                closest = Intersect(*intersection, item);
+            }
+            return intersection->dist;
+        });
+        return closest;
+    }
+
+    /// Calls [func] on each stored item in order of increasing distance from [pos] to the item's bounds, visiting each
+    /// item exactly once. Uses a best-first search over nodes, ordered by their minimum distance from [pos].
+    /// Stops early if [func] returns WalkResult::kExit.
+    template <typename VisitFunc> // (ItemRef, F64) => WalkResult | void
+    void for_each_nearest(const Pos<N> &pos, VisitFunc func) const {
+        return_if(empty());
+        struct Candidate {
+            F64 dist;            // Minimum distance from pos
+            U32 node;            // Node to expand, if this is not an item
+            const ItemRef *item; // Item to visit, if any
+            pure bool operator>(const Candidate &rhs) const { return dist > rhs.dist; }
+        };
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+        queue.push({pos.dist(closest(Node::bbox(), pos)), Node::kRoot, nullptr});
+        while (!queue.empty()) {
+            const Candidate next = queue.top();
+            queue.pop();
+            if (next.item) {
+                if constexpr (std::is_void_v<std::invoke_result_t<VisitFunc &, const ItemRef &, F64>>) {
+                    func(*next.item, next.dist);
+                } else {
+                    return_if(func(*next.item, next.dist) == WalkResult::kExit);
+                }
+                continue;
+            }
+            const Node *current = node(next.node);
+            for (U64 i = 0; i < current->list.size(); ++i) {
+                // Items held by multiple nodes are only queued by the node holding their point closest to pos.
+                // This node is always at least as close as the item, so it is expanded before the item is due.
+                const Pos<N> pt = closest(current->boxes[i], pos);
+                if (current->bbox().contains(pt)) {
+                    queue.push({pos.dist(pt), Node::kNone, &current->list[i]});
+                }
+            }
+            for (U64 i = 0; i < E; ++i) {
+                if (const U32 child = current->children[i]; child != Node::kNone) {
+                    queue.push({pos.dist(closest(node(child)->bbox(), pos)), child, nullptr});
+                }
+            }
+        }
+    }
+
+    /// Returns up to [k] items nearest to [pos], ordered by increasing distance from [pos] to their bounds.
+    pure List<ItemRef> nearest(const Pos<N> &pos, const U64 k) const {
+        List<ItemRef> result;
+        return_if(k == 0, result);
+        for_each_nearest(pos, [&](const ItemRef &item, F64) {
+            result.push_back(item);
+            return result.size() < k ? WalkResult::kRecurse : WalkResult::kExit;
+        });
+        return result;
+    }
+
+    /// Returns all items with bounds within [radius] of [pos], ordered by increasing distance from [pos].
+    pure List<ItemRef> within(const Pos<N> &pos, const F64 radius) const {
+        List<ItemRef> result;
+        for_each_nearest(pos, [&](const ItemRef &item, const F64 dist) {
+            return_if(dist > radius, WalkResult::kExit);
+            result.push_back(item);
+            return WalkResult::kRecurse;
+        });
+        return result;
     }
 
     /// Returns true if there are any items stored in the given volume.
@@ -294,12 +543,12 @@ public:
 
     /// Returns the closest item which intersects with the line segment according to the distance function.
     /// Also returns the location and face of the intersection, if it exists.
+    /// Only visits nodes which the line passes through, but cannot stop early since [dist] is arbitrary.
     template <typename DistanceFunc> // Intersect => Maybe<F64>
     pure Maybe<Intersect> first_where(const Line<N> &line, DistanceFunc dist) const {
         Maybe<Intersect> closest = None;
         Maybe<F64> distance = None;
-        // TODO: Feels like we can improve this. Can potentially get a lot of volume which would not intersect.
-        for (auto item : (*this)[{floor(line.a()), ceil(line.b())}]) {
+        walk_along(line, [&](const ItemRef &item) -> Maybe<F64> {
             if (auto intersection = intersect(line, bbox(item))) {
                 Intersect inter(*intersection, item);
                 const Maybe<F64> len = dist(inter);
@@ -308,60 +557,126 @@ public:
                     closest = inter;
                 }
             }
-        }
+            return None;
+        });
         return closest;
     }
 
-    /// Returns a Range for unordered iteration over all items in this tree.
-    pure MRange<ItemRef> items() { return {begin(), end()}; }
-    pure Range<ItemRef> items() const { return {begin(), end()}; }
+    /// Calls [func] on the items whose bounds the line segment passes through, visiting nodes front-to-back along
+    /// the line. [func] returns the distance from the line's start to its hit on the item, or None if it missed.
+    /// Nodes and items which begin beyond the closest hit so far are skipped, so the walk ends soon after the first
+    /// hit. Items held by multiple nodes may be visited more than once.
+    template <typename HitFunc> // ItemRef => Maybe<F64>
+    void walk_along(const Line<N> &line, HitFunc func) const {
+        F64 closest = std::numeric_limits<F64>::max();
+        U32 frontier[kMaxFrontier];
+        F64 enters[kMaxFrontier];
+        U64 size = 0;
+        if (auto span = clip(line, Node::bbox())) {
+            frontier[size] = Node::kRoot;
+            enters[size++] = span->first;
+        }
+        while (size > 0) {
+            --size;
+            // Nodes are popped in order of increasing entry distance, as children are pushed in reverse ray order
+            // and each child's subtree is passed through before the next child is entered.
+            if (enters[size] > closest) {
+                continue;
+            }
+            const Node *current = node(frontier[size]);
+            for (U64 i = 0; i < current->list.size(); ++i) {
+                const ItemRef &item = current->list[i];
+                const auto span = clip(line, current->boxes[i]);
+                if (span && span->first <= closest) {
+                    if (const Maybe<F64> dist = func(item); dist.has_value() && *dist < closest) {
+                        closest = *dist;
+                    }
+                }
+            }
+            // Push children from furthest to nearest so that the nearest child is visited first.
+            const U64 start = size;
+            for (U64 i = 0; i < E; ++i) {
+                const U32 child = current->children[i];
+                if (child != Node::kNone) {
+                    if (auto span = clip(line, node(child)->bbox()); span && span->first <= closest) {
+                        U64 j = size++;
+                        for (; j > start && enters[j - 1] < span->first; --j) {
+                            frontier[j] = frontier[j - 1];
+                            enters[j] = enters[j - 1];
+                        }
+                        frontier[j] = child;
+                        enters[j] = span->first;
+                    }
+                }
+            }
+        }
+    }
 
-    pure MIterator<ItemRef> begin() { return item_iterator::template begin<View::kMutable>(items_); }
-    pure MIterator<ItemRef> end() { return item_iterator::template end<View::kMutable>(items_); }
+    /// Returns a range for unordered iteration over all items in this tree.
+    pure IterRange<item_iterator> items() const { return {begin(), end()}; }
 
-    pure Iterator<ItemRef> begin() const { return item_iterator::template begin<View::kImmutable>(items_); }
-    pure Iterator<ItemRef> end() const { return item_iterator::template end<View::kImmutable>(items_); }
+    pure item_iterator begin() const { return item_iterator(items_.begin()); }
+    pure item_iterator end() const { return item_iterator(items_.end()); }
 
     /// Returns true if this item is contained within the tree.
-    pure bool has(const ItemRef &item) const { return item_ids_.has(item); }
+    pure bool has(const ItemRef &item) const { return entries_.has(item); }
 
     /// Returns the connected components in this tree.
+    /// Items are connected if they overlap or if they share part of a face, i.e. they touch in one dimension and
+    /// overlap in every other.
     pure List<Set<ItemRef>> components() const {
-        UnionFind<ItemRef> components;
-        for (const std::unique_ptr<Item> &a : items_.values()) {
-            ItemRef a_ref(a.get());
-            bool had_neighbors = false;
-            // Add overlapping boxes to the same component
-            const U64 a_id = item_ids_.get_or(a_ref, 0);
-            for (const ItemRef &b : collect(a->bbox())) {
-                if (item_ids_.get_or(b, 0) != a_id) {
-                    had_neighbors = true;
-                    components.add(a_ref, b);
-                }
-            }
-            // Adds neighboring boxes to the same component
-            for (const auto &edge : a->bbox().edges()) {
-                for (const ItemRef &b : collect(edge.bbox())) {
-                    had_neighbors = true;
-                    components.add(a_ref, b);
+        // Sweep items in order along the first axis, comparing each item only against the earlier items which still
+        // reach it along that axis.
+        List<std::pair<Box<N>, ItemRef>> items;
+        items.reserve(items_.size());
+        for (const auto &[_, item] : items_) {
+            const ItemRef ref(item.get());
+            items.emplace_back(bbox(ref), ref);
+        }
+        std::sort(items.begin(), items.end(),
+                  [](const auto &a, const auto &b) { return a.first.min[0] < b.first.min[0]; });
+
+        // Sets of indices into the sorted items
+        DenseUnionFind sets(items.size());
+        List<U64> active;
+        for (U64 i = 0; i < items.size(); ++i) {
+            const Box<N> &a = items[i].first;
+            U64 kept = 0;
+            for (U64 k = 0; k < active.size(); ++k) {
+                const U64 j = active[k];
+                const Box<N> &b = items[j].first;
+                // Items which end before this one begins can't reach any later item either
+                if (b.end[0] >= a.min[0]) {
+                    active[kept++] = j;
+                    if (connected(a, b)) {
+                        sets.merge(i, j);
+                    }
                 }
             }
-            // Add this item to its own component if it had no neighbors
-            if (!had_neighbors) {
-                components.add(a_ref);
-            }
+            active.resize(kept);
+            active.push_back(i);
         }
-        // Need to return this as a List to avoid references to the local `components` data structure.
+
         List<Set<ItemRef>> result;
-        for (const Set<ItemRef> &set : components.sets()) {
-            result.push_back(std::move(set));
+        result.reserve(sets.num_sets());
+        for (const std::span<const U64> set : sets.sets()) {
+            Set<ItemRef> &component = result.emplace_back();
+            for (const U64 i : set) {
+                component.insert(items[i].second);
+            }
         }
         return result;
     }
 
     /// Returns the current bounding box for this tree, if defined.
     /// Returns an empty box otherwise.
-    pure const Box<N> &bbox() const { return bbox_; }
+    pure const Box<N> &bbox() const {
+        if (stale_bbox_) {
+            bbox_ = stored_bbox();
+            stale_bbox_ = false;
+        }
+        return bbox_;
+    }
 
     /// Returns the shape of the bounding box for this tree.
     pure Pos<N> shape() const { return bbox().shape(); }
@@ -378,31 +693,50 @@ public:
     /// Returns the maximum depth, in nodes, of this tree. O(N) with number of nodes in the tree.
     pure U64 depth() const {
         U64 depth = 0;
-        for (auto &[_, node] : nodes_) {
-            depth = std::max(depth, node.depth());
-        }
+        preorder_walk_nodes([&](const Node *node) {
+            depth = std::max(depth, depth_of(node));
+            return WalkResult::kRecurse;
+        });
         return depth;
     }
 
+    /// Recomputes the bounding box of this tree from the boxes held by its nodes, then shrinks the root grid to fit it.
+    /// This is done automatically, at most once, after removing items on the boundary of the tree (see remove).
+    /// Moving an item only ever grows the bounds, so this may be called on demand after many items have moved.
+    RTree &compact() {
+        if (items_.empty()) {
+            clear();
+            return *this;
+        }
+        bbox_ = stored_bbox();
+        stale_bbox_ = false;
+        stale_grid_ = false;
+        shrink();
+        return *this;
+    }
+
     /// Resets this tree, dropping all items and nodes.
     void clear() {
-        item_ids_.clear();
+        entries_.clear();
         nodes_.clear();
         items_.clear();
-        node_id_ = 1;
         item_id_ = 0;
         bbox_ = Box<N>::kEmpty;
+        stale_bbox_ = false;
+        stale_grid_ = false;
         this->grid_size = kGridMin;
         this->origin = Pos<N>::fill(0);
         this->list.clear();
-        this->children = Tuple<E, Node *>::fill(nullptr);
+        this->entries.clear();
+        this->boxes.clear();
+        this->children = Tuple<E, U32>::fill(Node::kNone);
     }
 
     /// Dumps a string representation of this tree to stdout.
     void dump() const {
         indented(0) << "[[RTree with bounds " << bbox() << "]]" << std::endl;
         preorder_walk_nodes_in(bbox_, [&](const Node *node) {
-            const U64 indent = node->depth();
+            const U64 indent = depth_of(node);
             indented(indent) << "[#" << node->id << "][" << node->origin << "+/-" << node->grid_size
                              << "]:" << std::endl;
             for (const ItemRef &item : node->list) {
@@ -413,11 +747,14 @@ public:
     }
 
 protected:
+    using Slot = detail::Slot;
+    using Entry = detail::Entry;
+
     struct Garbage {
         explicit Garbage(RTree *parent) : parent(parent) {}
         ~Garbage() {
             for (const Node *removed : removed_nodes) {
-                parent->nodes_.erase(removed->id);
+                parent->nodes_.release(removed->id - 1);
             }
         }
         List<Node *> removed_nodes;
@@ -426,16 +763,7 @@ protected:
 
     pure Set<ItemRef> collect(const Box<N> &box) const {
         Set<ItemRef> items;
-        return_if(!bbox().overlaps(box), items);
-
-        detail::unconditional_preorder_walk_nodes_in(this, box, [&](const Node *node) {
-            for (const ItemRef &item : node->list) {
-                if (box.overlaps(bbox(item))) {
-                    items.insert(item);
-                }
-            }
-        });
-
+        for_each_in(box, [&](const ItemRef &item) { items.insert(item); });
         return items;
     }
 
@@ -444,34 +772,109 @@ protected:
 
         Maybe<ItemRef> result = None;
         preorder_walk_nodes_in(box, [&](const Node *node) {
-            for (const ItemRef &item : node->list) {
-                if (box.overlaps(bbox(item))) {
-                    result = item;
-                }
-            }
-            return result.has_value() ? WalkResult::kExit : WalkResult::kRecurse;
+            return node->for_each_overlapping(box, [&](const U64 i) {
+                result = node->list[i];
+                return WalkResult::kExit;
+            });
         });
         return result;
     }
 
-    Node *next_node(Node *parent, const Pos<N> &origin, const I64 grid_size) {
-        const U64 id = node_id_++;
-        return &nodes_.emplace(std::piecewise_construct, std::forward_as_tuple(id),
-                               std::forward_as_tuple(parent, id, origin, grid_size));
+    // Maximum number of pending nodes during a preorder walk. Each level of the tree adds at most E - 1 pending
+    // siblings, and there are at most 64 levels since each level halves the (64-bit) grid size.
+    static constexpr U64 kMaxFrontier = 64 * (E - 1) + 1;
+
+    /// Walks all nodes which overlap [shape], which is either a Box<N> or any volume with a conservative
+    /// `overlaps(const Box<N> &)` test (see for_each_overlapping).
+    template <typename Tree, typename Shape, typename VisitFunc> // Node* => WalkResult
+    static void walk_nodes_in(Tree &tree, const Shape &box, VisitFunc &func) {
+        U32 frontier[kMaxFrontier];
+        U64 size = 0;
+        if (box.overlaps(tree.node(Node::kRoot)->bbox())) {
+            frontier[size++] = Node::kRoot;
+        }
+        while (size > 0) {
+            auto *current = tree.node(frontier[--size]);
+            const WalkResult result = func(current);
+            return_if(result == WalkResult::kExit);
+            if (result == WalkResult::kRecurse) {
+                for (U64 i = 0; i < E; ++i) {
+                    const U32 child = current->children[i];
+                    if (child != Node::kNone && box.overlaps(tree.node(child)->bbox())) {
+                        frontier[size++] = child;
+                    }
+                }
+            }
+        }
+    }
+
+    /// Returns the first node holding the item of [entry] which overlaps [shape], or kNone if there is none.
+    /// Every node overlapping [shape] is visited when walking over [shape], so this is the single node which should
+    /// report the item. Unlike Node::owns, this does not require [shape] to be a box.
+    template <typename Shape>
+    pure U32 owner(const detail::Entry &entry, const Shape &shape) const {
+        return_if(entry.slots.size() == 1, entry.slots[0].node);
+        for (const detail::Slot &slot : entry.slots) {
+            return_if(shape.overlaps(node(slot.node)->bbox()), slot.node);
+        }
+        return Node::kNone;
+    }
+
+    /// Returns the point within [box] which is closest to [pos].
+    pure static Pos<N> closest(const Box<N> &box, const Pos<N> &pos) {
+        Pos<N> pt;
+        for (U64 i = 0; i < N; ++i) {
+            pt[i] = std::clamp(pos[i], box.min[i], box.end[i] - 1);
+        }
+        return pt;
+    }
+
+    /// Returns the node with the given id. The root node is this tree, all other nodes are held in the pool.
+    pure expand Node *node(const U32 id) { return id == Node::kRoot ? this : &nodes_[id - 1]; }
+    pure expand const Node *node(const U32 id) const { return id == Node::kRoot ? this : &nodes_[id - 1]; }
+
+    /// Returns the depth of [node] below the root.
+    pure U64 depth_of(const Node *node) const {
+        U64 depth = 0;
+        while (node->parent != Node::kNone) {
+            node = this->node(node->parent);
+            depth += 1;
+        }
+        return depth;
+    }
+
+    Node *next_node(const Node *parent, const Pos<N> &origin, const I64 grid_size) {
+        const U32 id = nodes_.alloc() + 1;
+        Node *node = &nodes_[id - 1];
+        node->reset(parent->id, id, origin, grid_size);
+        return node;
     }
 
     /// Pushes list entries down if [node] has exceeded the maximum entries, creating new children when necessary.
     /// Returns the list of direct children of [node] that were updated.
-    List<Node *> balance_only(Node *node) {
+    /// Slot records of moved items are only kept in sync if [slots] is true, otherwise see record_slots.
+    List<Node *> balance_only(Node *node, const bool slots) {
         return_if(node->grid_size <= kGridMin || node->list.size() <= kMaxEntries, {}); // Skip balancing
-        List<ItemRef> move;
-        List<ItemRef> keep;
-        for (const ItemRef &item : node->list) {
-            auto box = bbox(item);
-            const I64 min = box.shape().min();
+        List<U32> move;
+        List<U32> keep;
+        List<U32> halves; // Halves of [node] overlapped by each moved item: bit d is the lower half along d, N + d upper
+        const Pos<N> &origin = node->origin;
+        const I64 size = node->grid_size;
+        // Index-based loops here avoid type-erased iterators, as this is called for every node during bulk loading
+        for (U32 i = 0; i < node->list.size(); ++i) {
+            const Box<N> box = node->boxes[i];
             // Only push down entries which are smaller than this node's granularity
-            List<ItemRef> &list = min < node->grid_size ? move : keep;
-            list.push_back(item);
+            if (box.shape().min() < size) {
+                U32 bits = 0;
+                for (U64 d = 0; d < N; ++d) {
+                    bits |= static_cast<U32>(box.min[d] < origin[d] && box.end[d] > origin[d] - size) << d;
+                    bits |= static_cast<U32>(box.end[d] > origin[d] && box.min[d] < origin[d] + size) << (N + d);
+                }
+                move.push_back(i);
+                halves.push_back(bits);
+            } else {
+                keep.push_back(i);
+            }
         }
         return_if(move.empty(), {});
 
@@ -479,162 +882,359 @@ protected:
         const U64 child_size = node->grid_size / 2;
         Orthants<N>::walk([&](const Pos<N> &delta, const U64 i) {
             const Pos<N> child_origin = node->origin + delta * child_size;
-            const Box<N> child_box{child_origin - child_size, child_origin + child_size};
+            // An item overlaps this child if it overlaps the matching half of [node] along every dimension
+            U32 need = 0;
+            for (U64 d = 0; d < N; ++d) {
+                need |= 1u << (delta[d] < 0 ? d : N + d);
+            }
 
-            List<ItemRef> child_items;
-            for (const ItemRef &item : move) {
-                if (bbox(item).overlaps(child_box)) {
-                    child_items.push_back(item);
-                }
+            U64 count = 0;
+            for (U64 m = 0; m < move.size(); ++m) {
+                count += (halves[m] & need) == need;
             }
-            if (!child_items.empty()) {
-                Node *child = node->children[i];
-                if (child == nullptr) {
-                    child = node->children[i] = next_node(node, child_origin, child_size);
+            return_if(count == 0);
+            Node *child = node->children[i] == Node::kNone ? nullptr : this->node(node->children[i]);
+            if (child == nullptr) {
+                child = next_node(node, child_origin, child_size);
+                child->reserve(count);
+                node->children[i] = child->id;
+            }
+            for (U64 m = 0; m < move.size(); ++m) {
+                if ((halves[m] & need) == need) {
+                    const U32 j = move[m];
+                    append(child, node->list[j], node->entries[j], node->boxes[j], slots);
                 }
-                child->list.append(child_items);
-                updated.push_back(child);
             }
+            updated.push_back(child);
         });
-        node->list = keep;
+        // Moved items no longer live in this node. Kept items are compacted to the front of the list.
+        for (U64 m = 0; slots && m < move.size(); ++m) {
+            drop_slot(*node->entries[move[m]], node->id);
+        }
+        for (U32 k = 0; k < keep.size(); ++k) {
+            const U32 j = keep[k];
+            if (slots) {
+                find_slot(*node->entries[j], node->id)->index = k;
+            }
+            node->list[k] = node->list[j];
+            node->entries[k] = node->entries[j];
+            node->boxes.set(k, node->boxes[j]);
+        }
+        node->list.resize(keep.size());
+        node->entries.resize(keep.size());
+        node->boxes.resize(keep.size());
         return updated;
     }
 
     /// Recursively balances all nodes at and below [node], starting with [node].
-    void balance(Node *node) {
+    void balance(Node *node, const bool slots = true) {
         List<Node *> frontier{node};
         while (!frontier.empty()) {
             Node *current = frontier.back();
             frontier.pop_back();
-            frontier.append(balance_only(current));
+            frontier.append(balance_only(current, slots));
         }
     }
 
+    /// Rebuilds the slot records of every item from the lists of all nodes, in a single pass over the tree.
+    /// Existing records are first cleared if [clear] is true.
+    void record_slots(const bool clear) {
+        if (clear) {
+            for (auto &[_, entry] : entries_) {
+                entry.slots.clear();
+            }
+        }
+        preorder_walk_nodes([](Node *node) {
+            for (U32 i = 0; i < node->list.size(); ++i) {
+                node->entries[i]->slots.push_back({node->id, i});
+            }
+            return WalkResult::kRecurse;
+        });
+    }
+
     /// Removes all empty nodes above and including [node].
     void remove_if_empty(Garbage &garbage, Node *node) {
         while (node) {
-            Node *parent = node->parent;
-            return_if(!node->empty() || !parent);
+            return_if(!node->empty() || node->parent == Node::kNone);
+            Node *parent = this->node(node->parent);
             garbage.removed_nodes.push_back(node);
-            parent->remove_child(node);
+            parent->remove_child(node->id);
             node = parent;
         }
     }
 
-    /// Removes [item] from [node], if it exists.
-    /// Then recursively removes any empty nodes above and including [node].
-    bool remove(Garbage &garbage, Node *node, const ItemRef &item) {
-        // TODO: O(N) with number of items here
-        const bool changed = node->list.remove(item);
-        if (changed) {
-            remove_if_empty(garbage, node);
+    /// Returns the slot of [entry] within the node with the given id. The entry must be held by that node.
+    pure static Slot *find_slot(Entry &entry, const U32 node_id) {
+        for (U64 i = 0; i < entry.slots.size(); ++i) {
+            return_if(entry.slots[i].node == node_id, &entry.slots[i]);
+        }
+        return nullptr;
+    }
+
+    /// Drops the record of [entry] being held by the node with the given id.
+    static void drop_slot(Entry &entry, const U32 node_id) {
+        Slot *slot = find_slot(entry, node_id);
+        *slot = entry.slots.back();
+        entry.slots.pop_back();
+    }
+
+    /// Appends [item] with bounding box [box] to the list in [node], recording its location in [entry].
+    /// Records the new slot in [entry] only if [slots] is true.
+    static void append(Node *node, const ItemRef &item, Entry *entry, const Box<N> &box, const bool slots) {
+        if (slots) {
+            entry->slots.push_back({node->id, static_cast<U32>(node->list.size())});
         }
-        return changed;
+        node->list.push_back(item);
+        node->entries.push_back(entry);
+        node->boxes.push_back(box);
+    }
+    static void push(Node *node, const ItemRef &item, Entry *entry, const Box<N> &box) {
+        append(node, item, entry, box, /*slots*/ true);
+    }
+    static void push(Node *node, const ItemRef &item, Entry *entry) { push(node, item, entry, bbox(item)); }
+
+    /// Removes the item at [index] in the list in [node] in O(1) by moving the last item in the list into its place.
+    /// Does not update the removed item's entry.
+    void erase(Node *node, const U32 index) {
+        const U32 last = static_cast<U32>(node->list.size() - 1);
+        if (index != last) {
+            find_slot(*node->entries[last], node->id)->index = index;
+            node->list[index] = node->list[last];
+            node->entries[index] = node->entries[last];
+            node->boxes.set(index, node->boxes[last]);
+        }
+        node->list.pop_back();
+        node->entries.pop_back();
+        node->boxes.pop_back();
     }
 
-    Maybe<std::pair<U64, ItemRef>> get_item(const ItemRef &item) {
-        if (auto iter = item_ids_.find(item); iter != item_ids_.end()) {
-            return Some(std::pair<U64, ItemRef>{iter->second, iter->first});
+    /// Removes [item] from every node which holds it.
+    /// Then recursively removes any empty nodes above and including those nodes.
+    void remove(Garbage &garbage, Entry &entry) {
+        for (U64 i = 0; i < entry.slots.size(); ++i) {
+            Node *node = this->node(entry.slots[i].node);
+            erase(node, entry.slots[i].index);
+            remove_if_empty(garbage, node);
         }
-        return None;
+        entry.slots.clear();
     }
 
-    void add_and_balance(const ItemRef &ref) {
-        bbox_ = bounding_box(bbox_, bbox(ref));
-        const I64 cur_size = this->grid_size;
+    /// Returns the root grid size required to cover [box].
+    pure static I64 grid_size_for(const Box<N> &box) {
         // Possible optimization: Use the shape of the bounding box, not its coordinates, to set the grid size.
         // This would require changing the origins. Unclear how to do this without changing every node.
-        I64 max_exp = std::max<I64>(kGridMin, bit_width(abs(bbox_.min).max()));
-        max_exp = std::max<I64>(max_exp, bit_width(abs(bbox_.end).max()));
-        const I64 max_size = static_cast<I64>(1) << max_exp;
+        I64 max_exp = std::max<I64>(kGridMin, bit_width(abs(box.min).max()));
+        max_exp = std::max<I64>(max_exp, bit_width(abs(box.end).max()));
+        return static_cast<I64>(1) << max_exp;
+    }
+
+    /// Returns the bounding box of the boxes held by all nodes. These are the boxes of the items when they were last
+    /// added or moved, so the root grid is never shrunk below boxes which its nodes still hold.
+    pure Box<N> stored_bbox() const {
+        Box<N> box = Box<N>::kEmpty;
+        preorder_walk_nodes([&](const Node *node) {
+            for (U64 i = 0; i < node->boxes.size(); ++i) {
+                box = bounding_box(box, node->boxes[i]);
+            }
+            return WalkResult::kRecurse;
+        });
+        return box;
+    }
+
+    /// Returns true if [box] lies on the boundary of the bounding box of this tree.
+    pure bool on_bounds(const Box<N> &box) const {
+        for (U64 i = 0; i < N; ++i) {
+            return_if(box.min[i] <= bbox_.min[i] || box.end[i] >= bbox_.end[i], true);
+        }
+        return false;
+    }
+
+    /// Halves the root grid size until it is the smallest size which covers the current bounding box.
+    /// When the root shrinks, each root orthant is replaced by its innermost child, which covers exactly the new
+    /// orthant. All other children must already be empty, since no item lies outside the new grid. Items held by
+    /// the replaced nodes themselves are moved back to the root and rebalanced.
+    void shrink() {
+        const I64 min_size = grid_size_for(bbox_);
+        return_if(this->grid_size <= min_size);
+        {
+            Garbage garbage(this);
+            while (this->grid_size > min_size) {
+                Orthants<N>::walk([&](const Pos<N> &delta, const U64 i) {
+                    return_if(this->children[i] == Node::kNone);
+                    Node *child = this->node(this->children[i]);
+                    for (U64 j = 0; j < child->list.size(); ++j) {
+                        Entry *entry = child->entries[j];
+                        drop_slot(*entry, child->id);
+                        if (find_slot(*entry, Node::kRoot) == nullptr) {
+                            push(this, child->list[j], entry, child->boxes[j]);
+                        }
+                    }
+                    const U32 inner = child->children[Orthants<N>::nd_to_flat(delta * -1)];
+                    if (inner != Node::kNone) {
+                        this->node(inner)->parent = Node::kRoot;
+                    }
+                    this->children[i] = inner;
+                    child->reset(Node::kNone, child->id, child->origin, child->grid_size);
+                    garbage.removed_nodes.push_back(child);
+                });
+                this->grid_size /= 2;
+            }
+            // An item moved up to the root may also be held by a promoted subtree if it straddled the boundary of the
+            // removed child. Items are held either by the root or by its descendants, never both, so drop the copies
+            // held by descendants before rebalancing.
+            for (Entry *entry : this->entries) {
+                U64 s = 0;
+                while (s < entry->slots.size()) {
+                    const Slot slot = entry->slots[s];
+                    if (slot.node == Node::kRoot) {
+                        ++s;
+                    } else {
+                        Node *node = this->node(slot.node);
+                        erase(node, slot.index);
+                        drop_slot(*entry, slot.node); // Moves the last slot into index s
+                        remove_if_empty(garbage, node);
+                    }
+                }
+            }
+        }
+        balance(this);
+    }
+
+    /// Extends the bounding box of this tree to include [box], growing the root grid if necessary.
+    void grow(const Box<N> &box) {
+        bbox_ = bounding_box(bbox_, box);
+        const I64 cur_size = this->grid_size;
+        const I64 max_size = grid_size_for(bbox_);
         if (cur_size < max_size) {
             Orthants<N>::walk([&](const Pos<N> &delta, const U64 i) {
                 // Rebalance children to match the new desired maximum grid size. Skip if already sufficiently sized.
-                if (Node *prev = this->children[i]) {
-                    for (I64 next_size = cur_size << 1; next_size <= max_size; next_size = next_size << 1) {
+                if (this->children[i] != Node::kNone) {
+                    Node *prev = this->node(this->children[i]);
+                    // Each wrapper covers exactly one orthant of the next level up, ending at the new root's orthant.
+                    for (I64 next_size = cur_size; next_size < max_size; next_size = next_size << 1) {
                         const Pos<N> origin = this->origin + delta * next_size;
                         Node *next = next_node(this, origin, next_size);
                         const U64 index = *next->index(prev->origin);
-                        next->children[index] = prev;
-                        this->children[i] = next;
-                        prev->parent = next;
+                        next->children[index] = prev->id;
+                        this->children[i] = next->id;
+                        prev->parent = next->id;
                         prev = next;
                     }
                 }
             });
             this->grid_size = max_size;
         }
+    }
 
-        this->list.push_back(ref);
+    void add_and_balance(const ItemRef &ref, Entry *entry) {
+        if (stale_grid_) {
+            compact();
+        }
+        const Box<N> box = bbox(ref);
+        grow(box);
+        push(this, ref, entry, box);
         balance(this);
     }
 
-    RTree &move_from(const ItemRef &item, const Box<N> &old_box) {
-        if (auto pair = get_item(item)) {
-            auto [_, ref] = *pair;
-            Garbage garbage(this);
-            remove_over(ref, old_box, /*remove_all*/ false);
-            add_and_balance(ref);
+    /// Adds all [refs] to the root and builds the hierarchy below it top-down. Slots are not tracked while items are
+    /// pushed down, and are instead recorded once for every item at the end.
+    void add_and_balance(const List<ItemRef> &refs, const List<Entry *> &entries) {
+        return_if(refs.empty());
+        if (stale_grid_) {
+            compact();
+        }
+        List<Box<N>> boxes;
+        boxes.reserve(refs.size());
+        for (const ItemRef &ref : refs) {
+            boxes.push_back(bbox(ref));
+        }
+        Box<N> box = boxes.front();
+        for (U64 i = 1; i < boxes.size(); ++i) {
+            box = bounding_box(box, boxes[i]);
+        }
+        grow(box);
+        for (U64 i = 0; i < refs.size(); ++i) {
+            append(this, refs[i], entries[i], boxes[i], /*slots*/ false);
+        }
+        balance(this, /*slots*/ false);
+        record_slots(/*clear*/ entries_.size() > refs.size()); // Only items which were already held have records
+    }
+
+    RTree &move_from(const ItemRef &item) {
+        if (Entry *entry = entries_.get(item)) {
+            {
+                Garbage garbage(this);
+                remove(garbage, *entry);
+            }
+            add_and_balance(item, entry);
         }
         return *this;
     }
 
-    ItemRef insert_over(const Item &item) {
+    /// Takes ownership of [item] without adding it to any node. Returns the stored item and its new entry.
+    std::pair<ItemRef, Entry *> store(std::unique_ptr<Item> item) {
         const U64 id = ++item_id_;
-        auto &unique = items_[id] = std::make_unique<Item>(item); // Copy constructor
+        auto &unique = items_[id] = std::move(item);
         ItemRef ref(unique.get());
-        item_ids_[ref] = id;
-        add_and_balance(ref);
+        Entry &entry = entries_[ref];
+        entry.id = id;
+        return {ref, &entry};
+    }
+
+    ItemRef insert_over(const Item &item) {
+        const auto [ref, entry] = store(std::make_unique<Item>(item)); // Copy constructor
+        add_and_balance(ref, entry);
         return ref;
     }
 
     ItemRef take_over(std::unique_ptr<Item> item) {
-        const U64 id = ++item_id_;
-        auto &unique = items_[id] = std::move(item);
-        ItemRef ref(unique.get());
-        item_ids_[ref] = id;
-        add_and_balance(ref);
+        const auto [ref, entry] = store(std::move(item));
+        add_and_balance(ref, entry);
         return ref;
     }
 
     template <typename T, typename... Args>
     ItemRef emplace_over(Args &&...args) {
-        const U64 id = ++item_id_;
-        auto &unique = items_[id] = std::move(std::make_unique<T>(std::forward<Args>(args)...));
-        ItemRef ref(unique.get());
-        item_ids_[ref] = id;
-        add_and_balance(ref);
+        const auto [ref, entry] = store(std::make_unique<T>(std::forward<Args>(args)...));
+        add_and_balance(ref, entry);
         return ref;
     }
 
-    RTree &remove_over(const ItemRef item, const Box<N> &box, const bool remove_all) {
-        // TODO: Update bounds?
-        if (auto pair = get_item(item)) {
-            Garbage garbage(this);
-            const ItemRef &ptr = pair->second;
-            preorder_walk_nodes_in(box, [&](Node *node) {
-                // Don't continue to recurse if item was found in this node
-                return remove(garbage, node, ptr) ? WalkResult::kNoRecurse : WalkResult::kRecurse;
-            });
-            if (remove_all) {
-                items_.remove(pair->first);
-                item_ids_.remove(pair->second);
+    /// Removes [item] from this tree, if it exists.
+    /// Marks the bounds as stale if the item was on the boundary of the tree, i.e. if the tree may now be compacted.
+    void remove_over(const ItemRef item) {
+        Entry *entry = entries_.get(item);
+        return_if(entry == nullptr);
+        if (!stale_bbox_ && !entry->slots.empty()) {
+            const Slot slot = entry->slots.front();
+            if (on_bounds(this->node(slot.node)->boxes[slot.index])) {
+                stale_bbox_ = true;
+                stale_grid_ = true;
             }
         }
-        return *this;
+        {
+            Garbage garbage(this);
+            remove(garbage, *entry);
+        }
+        items_.remove(entry->id);
+        entries_.remove(item);
     }
 
-    Box<N> bbox_ = Box<N>::kEmpty;
-    U64 node_id_ = 1;
+    // The bounding box and root grid may be larger than needed after removing an item on the boundary of the tree.
+    // Both are recomputed lazily (see remove) so that removing many items at once only rescans the tree once.
+    mutable Box<N> bbox_ = Box<N>::kEmpty;
+    mutable bool stale_bbox_ = false; // True until bbox_ is recomputed after removing an item on the boundary
+    bool stale_grid_ = false;         // True until the root grid is shrunk after removing an item on the boundary
     U64 item_id_ = 0;
 
-    // Nodes keep references to the items stored in the items_ map to avoid storing two copies of each item.
-    // These references are guaranteed stable as long as the item itself is not removed from the map.
-    // See: https://cplusplus.com/reference/unordered_map/unordered_map/operator[]/
-    Map<U64, std::unique_ptr<Item>> items_;
-    Map<ItemRef, U64> item_ids_;
+    // Nodes keep references to the items owned by the items_ map to avoid storing two copies of each item.
+    // Items are heap allocated, so these references are stable as long as the item is not removed from the map.
+    FlatMap<U64, std::unique_ptr<Item>> items_;
+    // Nodes also keep pointers to entries, so these must be stable across insertions (unlike FlatMap entries).
+    Map<ItemRef, Entry> entries_;
 
-    Map<U64, Node> nodes_;
+    // All nodes except the root. Node ids are offset by one from their index in the pool, as id 0 is the root.
+    Pool<Node> nodes_;
 };
 
 } // namespace nvl
@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <iterator>
 #include <sstream>
+#include <type_traits>
 
 #include "nvl/data/Iterator.h"
 #include "nvl/data/Maybe.h"
@@ -14,9 +15,27 @@
 
 namespace nvl {
 
+namespace detail {
+#ifdef __AVX2__
+constexpr bool kPadTuples = true; // Four 64-bit elements fit in one vector register
+#else
+constexpr bool kPadTuples = false; // Padding only adds work when a vector holds two or fewer 64-bit elements
+#endif
+
+/// Number of elements stored for a Tuple<N, T>. When targeting AVX2, tuples of two or three I64 or F64 elements,
+/// e.g. Pos<3> and Vec<3>, are padded to four elements so that element-wise operations and comparisons compile to
+/// whole-vector instructions.
+template <U64 N, typename T>
+constexpr U64 kTupleLanes =
+    kPadTuples && (N == 2 || N == 3) && (std::is_same_v<T, I64> || std::is_same_v<T, F64>) ? 4 : N;
+} // namespace detail
+
 /**
  * @class Tuple
  * @brief A tuple with N elements of type T.
+ *
+ * Elements past N in padded tuples (see detail::kTupleLanes) are always zero. Operations where zero is preserved,
+ * e.g. element-wise addition or min, run over every lane. All other operations only touch the first N elements.
  * @tparam N - Number of elements in this tuple.
  * @tparam T - Type of elements.
  */
@@ -25,6 +44,9 @@ class Tuple {
 public:
     using value_type = T;
 
+    static constexpr U64 kLanes = detail::kTupleLanes<N, T>; // Number of stored elements, including padding
+    static constexpr bool kPadded = kLanes != N;
+
     struct iterator final : AbstractIteratorCRTP<iterator, T> {
         class_tag(Tuple::iterator, AbstractIterator<T>);
 
@@ -72,8 +94,14 @@ public:
     /// An instance of rank `N` where all elements are one.
     static const Tuple ones;
 
-    /// Returns a Tuple of rank `N` with uninitialized elements.
-    explicit constexpr Tuple() = default;
+    /// Returns a Tuple of rank `N` with uninitialized elements. Padding is zeroed.
+    explicit constexpr Tuple() {
+        if constexpr (kPadded) {
+            for (U64 i = N; i < kLanes; ++i) {
+                indices_[i] = 0;
+            }
+        }
+    }
 
     explicit constexpr Tuple(T a)
         requires(N == 1)
@@ -127,14 +155,14 @@ public:
     /// Returns a copy with every element negated.
     pure Tuple operator-() const {
         Tuple result = *this;
-        simd for (T &x : result.indices_) { x = -x; }
+        simd for (U64 i = 0; i < N; ++i) { result[i] = -result[i]; }
         return result;
     }
 
     /// Returns a new instance with the result of element-wise multiplication.
     pure Tuple operator*(const Tuple &rhs) const {
         Tuple result;
-        simd for (U64 i = 0; i < N; ++i) { result[i] = indices_[i] * rhs.indices_[i]; }
+        simd for (U64 i = 0; i < kLanes; ++i) { result[i] = indices_[i] * rhs.indices_[i]; }
         return result;
     }
 
@@ -157,28 +185,28 @@ public:
     /// Returns a new instance with the result of element-wise addition.
     pure Tuple operator+(const Tuple &rhs) const {
         Tuple result;
-        simd for (U64 i = 0; i < N; ++i) { result[i] = indices_[i] + rhs.indices_[i]; }
+        simd for (U64 i = 0; i < kLanes; ++i) { result[i] = indices_[i] + rhs.indices_[i]; }
         return result;
     }
 
     /// Returns a new instance with the result of element-wise subtraction.
     pure Tuple operator-(const Tuple &rhs) const {
         Tuple result;
-        simd for (U64 i = 0; i < N; ++i) { result[i] = indices_[i] - rhs.indices_[i]; }
+        simd for (U64 i = 0; i < kLanes; ++i) { result[i] = indices_[i] - rhs.indices_[i]; }
         return result;
     }
 
     /// Returns a new instance with the result of element-wise multiplication.
     pure Tuple operator*(const T rhs) const {
         Tuple result = *this;
-        simd for (T &x : result.indices_) { x *= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { result[i] *= rhs; }
         return result;
     }
 
     /// Returns a new instance with the result of element-wise division.
     pure Tuple operator/(const T rhs) const {
         Tuple result = *this;
-        simd for (T &x : result.indices_) { x /= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { result[i] /= rhs; }
         return result;
     }
 
@@ -187,32 +215,38 @@ public:
         requires std::is_integral_v<T>
     {
         Tuple result = *this;
-        simd for (T &x : result.indices_) { x %= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { result[i] %= rhs; }
         return result;
     }
 
     /// Returns a new instance with the result of element-wise addition.
     pure Tuple operator+(const T rhs) const {
         Tuple result = *this;
-        simd for (T &x : result.indices_) { x += rhs; }
+        simd for (U64 i = 0; i < N; ++i) { result[i] += rhs; }
         return result;
     }
 
     /// Returns a new instance with the result of element-wise subtraction.
     pure Tuple operator-(const T rhs) const {
         Tuple result = *this;
-        simd for (T &x : result.indices_) { x -= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { result[i] -= rhs; }
         return result;
     }
 
     /// Returns true if the two instances have identical elements.
     pure bool operator==(const Tuple &rhs) const {
-        simd for (U64 i = 0; i < N; ++i) {
-            if (indices_[i] != rhs.indices_[i]) {
-                return false;
+        if constexpr (kPadded) {
+            bool equal = true;
+            simd for (U64 i = 0; i < kLanes; ++i) { equal &= indices_[i] == rhs.indices_[i]; }
+            return equal;
+        } else {
+            simd for (U64 i = 0; i < N; ++i) {
+                if (indices_[i] != rhs.indices_[i]) {
+                    return false;
+                }
             }
+            return true;
         }
-        return true;
     }
 
     /// Returns true if the two instances do not have identical elements.
@@ -220,14 +254,27 @@ public:
 
     /// Returns true if every element is strictly less than the corresponding element in `rhs`.
     pure bool all_lt(const Tuple &rhs) const {
-        simd for (U64 i = 0; i < N; ++i) { return_if(indices_[i] >= rhs.indices_[i], false); }
-        return true;
+        if constexpr (kPadded) {
+            // Padding is zero on both sides, so exactly the first N lanes must compare less
+            U64 count = 0;
+            simd for (U64 i = 0; i < kLanes; ++i) { count += indices_[i] < rhs.indices_[i] ? 1 : 0; }
+            return count == N;
+        } else {
+            simd for (U64 i = 0; i < N; ++i) { return_if(indices_[i] >= rhs.indices_[i], false); }
+            return true;
+        }
     }
 
     /// Returns true if every element is less than or equal to the corresponding element in `rhs`.
     pure bool all_lte(const Tuple &rhs) const {
-        simd for (U64 i = 0; i < N; ++i) { return_if(indices_[i] > rhs.indices_[i], false); }
-        return true;
+        if constexpr (kPadded) {
+            bool lte = true;
+            simd for (U64 i = 0; i < kLanes; ++i) { lte &= indices_[i] <= rhs.indices_[i]; }
+            return lte;
+        } else {
+            simd for (U64 i = 0; i < N; ++i) { return_if(indices_[i] > rhs.indices_[i], false); }
+            return true;
+        }
     }
 
     /// Returns true if every element is greater than the corresponding element in `rhs`.
@@ -299,20 +346,20 @@ public:
 
     pure T product() const {
         T product = 1;
-        for (const T x : indices_)
-            product *= x;
+        for (U64 i = 0; i < N; ++i)
+            product *= indices_[i];
         return product;
     }
 
     pure T sum() const {
         T sum = 0;
-        for (const T x : indices_)
-            sum += x;
+        for (U64 i = 0; i < N; ++i)
+            sum += indices_[i];
         return sum;
     }
 
-    pure T max() const { return *std::max_element(std::begin(indices_), std::end(indices_)); }
-    pure T min() const { return *std::min_element(std::begin(indices_), std::end(indices_)); }
+    pure T max() const { return *std::max_element(std::begin(indices_), std::begin(indices_) + N); }
+    pure T min() const { return *std::min_element(std::begin(indices_), std::begin(indices_) + N); }
 
     pure Tuple strides() const {
         Tuple result;
@@ -324,7 +371,7 @@ public:
     }
 
     Tuple &operator*=(const Tuple &rhs) {
-        simd for (U64 i = 0; i < N; ++i) { indices_[i] *= rhs.indices_[i]; }
+        simd for (U64 i = 0; i < kLanes; ++i) { indices_[i] *= rhs.indices_[i]; }
         return *static_cast<Tuple *>(this);
     }
     Tuple &operator/=(const Tuple &rhs) {
@@ -336,31 +383,31 @@ public:
         return *static_cast<Tuple *>(this);
     }
     Tuple &operator+=(const Tuple &rhs) {
-        simd for (U64 i = 0; i < N; ++i) { indices_[i] += rhs.indices_[i]; }
+        simd for (U64 i = 0; i < kLanes; ++i) { indices_[i] += rhs.indices_[i]; }
         return *static_cast<Tuple *>(this);
     }
     Tuple &operator-=(const Tuple &rhs) {
-        simd for (U64 i = 0; i < N; ++i) { indices_[i] -= rhs.indices_[i]; }
+        simd for (U64 i = 0; i < kLanes; ++i) { indices_[i] -= rhs.indices_[i]; }
         return *static_cast<Tuple *>(this);
     }
     Tuple &operator*=(const T rhs) {
-        simd for (T &x : indices_) { x *= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { indices_[i] *= rhs; }
         return *this;
     }
     Tuple &operator/=(const T rhs) {
-        simd for (T &x : indices_) { x /= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { indices_[i] /= rhs; }
         return *this;
     }
     Tuple &operator%=(const T rhs) {
-        simd for (T &x : indices_) { x %= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { indices_[i] %= rhs; }
         return *this;
     }
     Tuple &operator+=(const T rhs) {
-        simd for (T &x : indices_) { x += rhs; }
+        simd for (U64 i = 0; i < N; ++i) { indices_[i] += rhs; }
         return *this;
     }
     Tuple &operator-=(const T rhs) {
-        simd for (T &x : indices_) { x -= rhs; }
+        simd for (U64 i = 0; i < N; ++i) { indices_[i] -= rhs; }
         return *this;
     }
 
@@ -376,7 +423,7 @@ public:
 
 protected:
     friend struct std::hash<Tuple>;
-    T indices_[N];
+    T indices_[kLanes];
 }; // namespace nvl
 
 template <U64 N>
@@ -394,14 +441,14 @@ const Tuple<N, T> Tuple<N, T>::ones = Tuple::fill(1);
 template <U64 N, typename T>
 Tuple<N, T> min(const Tuple<N, T> &a, const Tuple<N, T> &b) {
     Tuple<N, T> result;
-    simd for (U64 i = 0; i < N; ++i) { result[i] = std::min(a[i], b[i]); }
+    simd for (U64 i = 0; i < Tuple<N, T>::kLanes; ++i) { result[i] = std::min(a[i], b[i]); }
     return result;
 }
 
 template <U64 N, typename T>
 Tuple<N, T> max(const Tuple<N, T> &a, const Tuple<N, T> &b) {
     Tuple<N, T> result;
-    simd for (U64 i = 0; i < N; ++i) { result[i] = std::max(a[i], b[i]); }
+    simd for (U64 i = 0; i < Tuple<N, T>::kLanes; ++i) { result[i] = std::max(a[i], b[i]); }
     return result;
 }
 
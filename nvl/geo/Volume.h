@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cmath>
+#include <type_traits>
 
 #include "nvl/data/Counter.h"
+#include "nvl/data/IterRange.h"
 #include "nvl/data/Iterator.h"
 #include "nvl/data/List.h"
 #include "nvl/data/Maybe.h"
@@ -60,20 +62,15 @@ public:
 
     static const Volume kEmpty;
 
-    struct idx_iterator final : AbstractIteratorCRTP<idx_iterator, Idx> {
-        class_tag(Volume::idx_iterator, AbstractIterator<Idx>);
-
-        template <View Type = View::kImmutable>
-            requires(Type == View::kImmutable)
-        static Iterator<Idx, Type> begin(const Volume &box, const Idx &step) {
-            return make_iterator<idx_iterator>(box, box.min, step);
-        }
-        template <View Type = View::kImmutable>
-            requires(Type == View::kImmutable)
-        static Iterator<Idx, Type> end(const Volume &box, const Idx &step) {
-            return make_iterator<idx_iterator>(box, None, step);
-        }
+    /// Concrete iterator over the points in a volume with a given step size.
+    struct idx_iterator {
+        using value_type = Idx;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Idx &;
+        using pointer = const Idx *;
+        using iterator_category = std::forward_iterator_tag;
 
+        idx_iterator() = default;
         explicit idx_iterator(const Volume &box, const Maybe<Idx> &idx, const Idx &step)
             : box_(box), idx_(idx), step_(step) {
             for (U64 i = 0; i < N; i++) {
@@ -84,13 +81,14 @@ public:
                 idx_ = None;
         }
 
-        const Idx *ptr() override { return &idx_.value(); }
+        pure reference operator*() const { return idx_.value(); }
+        pure pointer operator->() const { return &idx_.value(); }
 
-        pure bool operator==(const idx_iterator &rhs) const override {
+        pure bool operator==(const idx_iterator &rhs) const {
             return idx_ == rhs.idx_ && box_ == rhs.box_ && step_ == rhs.step_;
         }
 
-        void increment() override {
+        idx_iterator &operator++() {
             // Increment only does something if this is not the end iterator.
             if (idx_.has_value()) {
                 auto &idx = idx_.value();
@@ -106,6 +104,12 @@ public:
                     }
                 }
             }
+            return *this;
+        }
+        idx_iterator operator++(int) {
+            idx_iterator prev = *this;
+            ++*this;
+            return prev;
         }
 
         Volume box_;
@@ -113,20 +117,15 @@ public:
         Idx step_;
     };
 
-    struct box_iterator final : AbstractIteratorCRTP<box_iterator, Volume> {
-        class_tag(Volume::box_iterator, AbstractIterator<Volume<N, T>>);
-
-        template <View Type = View::kImmutable>
-            requires(Type == View::kImmutable)
-        static Iterator<Volume, Type> begin(const Volume &box, const Idx &shape = Idx::fill(1)) {
-            return make_iterator<box_iterator, Type>(box, Volume(box.min, box.min + shape), shape);
-        }
-        template <View Type = View::kImmutable>
-            requires(Type == View::kImmutable)
-        static Iterator<Volume, Type> end(const Volume &box, const Idx &shape = Idx::fill(1)) {
-            return make_iterator<box_iterator, Type>(box, None, shape);
-        }
+    /// Concrete iterator over the sub-volumes of a volume with a given shape.
+    struct box_iterator {
+        using value_type = Volume;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Volume &;
+        using pointer = const Volume *;
+        using iterator_category = std::forward_iterator_tag;
 
+        box_iterator() = default;
         explicit box_iterator(const Volume &box, const Maybe<Volume> &cur, const Idx &shape)
             : box_(box), current_(cur), shape_(shape) {
             for (U64 i = 0; i < N; i++) {
@@ -137,13 +136,14 @@ public:
                 current_ = None;
         }
 
-        const Volume *ptr() override { return &current_.value(); }
+        pure reference operator*() const { return current_.value(); }
+        pure pointer operator->() const { return &current_.value(); }
 
-        pure bool operator==(const box_iterator &rhs) const override {
+        pure bool operator==(const box_iterator &rhs) const {
             return current_ == rhs.current_ && box_ == rhs.box_ && shape_ == rhs.shape_;
         }
 
-        void increment() override {
+        box_iterator &operator++() {
             if (current_.has_value()) {
                 I64 i = N - 1;
                 auto &current = current_.value();
@@ -161,6 +161,12 @@ public:
                     }
                 }
             }
+            return *this;
+        }
+        box_iterator operator++(int) {
+            box_iterator prev = *this;
+            ++*this;
+            return prev;
         }
 
         Volume box_;
@@ -214,16 +220,20 @@ public:
     pure Volume clamp(const I64 grid) const { return Volume(min.grid_min(grid), end.grid_max(grid)); }
 
     /// Returns an iterator over points in this box with the given `step` size in each dimension.
-    pure Range<Idx> indices(const I64 step = 1) const { return indices(Idx::fill(step)); }
+    pure IterRange<idx_iterator> indices(const I64 step = 1) const { return indices(Idx::fill(step)); }
 
     /// Returns an iterator over points in this box with the given multidimensional `step` size.
-    pure Range<Idx> indices(const Idx &step) const { return make_range<idx_iterator>(*this, step); }
+    pure IterRange<idx_iterator> indices(const Idx &step) const {
+        return {idx_iterator(*this, min, step), idx_iterator(*this, None, step)};
+    }
 
     /// Returns an iterator over sub-boxes with the given `step` size in each dimension.
-    pure Range<Volume> volumes(const I64 step) const { return make_range<box_iterator>(*this, Idx::fill(step)); }
+    pure IterRange<box_iterator> volumes(const I64 step) const { return volumes(Idx::fill(step)); }
 
     /// Returns an iterator over sub-boxes with the given multidimensional `step` size.
-    pure Range<Volume> volumes(const Idx &shape) const { return make_range<box_iterator>(*this, shape); }
+    pure IterRange<box_iterator> volumes(const Idx &shape) const {
+        return {box_iterator(*this, Volume(min, min + shape), shape), box_iterator(*this, None, shape)};
+    }
 
     /// Returns the number of sub-volumes an iterator with this shape would have.
     pure U64 num_volumes(const I64 step) const {
@@ -236,23 +246,31 @@ public:
 
     /// Returns true if there is any overlap between this Volume and `rhs`.
     pure bool overlaps(const Volume &rhs) const {
-        for (U64 i = 0; i < N; ++i) {
-            if (min[i] >= rhs.end[i] || rhs.min[i] >= end[i]) {
-                return false;
+        if constexpr (Idx::kPadded) {
+            return min.all_lt(rhs.end) & rhs.min.all_lt(end);
+        } else {
+            for (U64 i = 0; i < N; ++i) {
+                if (min[i] >= rhs.end[i] || rhs.min[i] >= end[i]) {
+                    return false;
+                }
             }
+            return true;
         }
-        return true;
     }
 
     /// Returns true if `pt` is contained within this box.
     template <typename R>
     pure bool contains(const Tuple<N, R> &pt) const {
-        for (U64 i = 0; i < N; ++i) {
-            if (pt[i] < min[i] || pt[i] >= end[i]) {
-                return false;
+        if constexpr (std::is_same_v<R, T> && Idx::kPadded) {
+            return min.all_lte(pt) & pt.all_lt(end);
+        } else {
+            for (U64 i = 0; i < N; ++i) {
+                if (pt[i] < min[i] || pt[i] >= end[i]) {
+                    return false;
+                }
             }
+            return true;
         }
-        return true;
     }
 
     /// Returns the Volume where this and `rhs` overlap. Returns None if there is no overlap.
@@ -352,7 +370,7 @@ public:
 
     /// Returns a range over the faces of this volume.
     /// Faces have a "thickness" of zero.
-    pure Range<Edge<N, T>> faces() const;
+    pure IterRange<face_iterator> faces() const;
 
     /// Returns the edges with given width and distance from the outermost pixel.
     /// Edges begin at `dist` "pixels" away from the outermost 'pixel" of the box and extend outwards.
@@ -466,30 +484,26 @@ struct Edge : Face {
     Volume<N, T> box;
 };
 
+/// Concrete iterator over the faces of a volume.
 template <U64 N, typename T>
-struct Volume<N, T>::face_iterator final : AbstractIteratorCRTP<face_iterator, Edge<N, T>> {
-    class_tag(Volume::face_iterator, AbstractIterator<Edge<N, T>>);
-
-    template <View Type = View::kImmutable>
-        requires(Type == View::kImmutable)
-    static Iterator<Edge<N, T>, Type> begin(const Volume &box) {
-        return make_iterator<face_iterator, Type>(box, Dir::Neg, 0);
-    }
-    template <View Type = View::kImmutable>
-        requires(Type == View::kImmutable)
-    static Iterator<Edge<N, T>, Type> end(const Volume &box) {
-        return make_iterator<face_iterator, Type>(box, Dir::Neg, N);
-    }
-
+struct Volume<N, T>::face_iterator {
+    using value_type = Edge<N, T>;
+    using difference_type = std::ptrdiff_t;
+    using reference = const Edge<N, T> &;
+    using pointer = const Edge<N, T> *;
+    using iterator_category = std::forward_iterator_tag;
+
+    face_iterator() = default;
     explicit face_iterator(const Volume &box, Dir dir, U64 dim) : box_(box), face_(dir, dim, box) { update_face(); }
 
-    const Edge<N, T> *ptr() override { return &face_; }
+    pure reference operator*() const { return face_; }
+    pure pointer operator->() const { return &face_; }
 
-    pure bool operator==(const face_iterator &rhs) const override {
+    pure bool operator==(const face_iterator &rhs) const {
         return box_ == rhs.box_ && face_.dim == rhs.face_.dim && face_.dir == rhs.face_.dir;
     }
 
-    void increment() override {
+    face_iterator &operator++() {
         if (face_.dim < N) {
             if (face_.dir == Dir::Neg) {
                 face_.dir = Dir::Pos;
@@ -499,6 +513,12 @@ struct Volume<N, T>::face_iterator final : AbstractIteratorCRTP<face_iterator, E
             }
             update_face();
         }
+        return *this;
+    }
+    face_iterator operator++(int) {
+        face_iterator prev = *this;
+        ++*this;
+        return prev;
     }
 
     void update_face() {
@@ -513,8 +533,8 @@ struct Volume<N, T>::face_iterator final : AbstractIteratorCRTP<face_iterator, E
 };
 
 template <U64 N, typename T>
-Range<Edge<N, T>> Volume<N, T>::faces() const {
-    return make_range<face_iterator>(*this);
+IterRange<typename Volume<N, T>::face_iterator> Volume<N, T>::faces() const {
+    return {face_iterator(*this, Dir::Neg, 0), face_iterator(*this, Dir::Neg, N)};
 }
 
 template <U64 N, typename T>
@@ -7,6 +7,7 @@ namespace nvl {
 
 #define F64 double
 #define I64 int64_t
+#define U32 uint32_t
 #define U64 size_t
 #define U8 uint8_t
 
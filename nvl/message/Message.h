@@ -1,9 +1,10 @@
 #pragma once
 
+#include <span>
 #include <string>
 
 #include "nvl/macros/Abstract.h"
-#include "nvl/reflect/CastableShared.h"
+#include "nvl/reflect/CastablePtr.h"
 #include "nvl/reflect/ClassTag.h"
 
 namespace nvl {
@@ -11,8 +12,9 @@ namespace nvl {
 struct AbstractActor;
 struct Actor;
 struct Message;
+class MessageArena;
 
-abstract class AbstractMessage : public CastableShared<Message, AbstractMessage>::BaseClass {
+abstract class AbstractMessage : public CastablePtr<Message, AbstractMessage>::BaseClass {
 public:
     class_tag(AbstractMessage);
     explicit AbstractMessage(AbstractActor *src) : src_(src) {}
@@ -22,13 +24,20 @@ public:
 
 protected:
     AbstractActor *src_;
+
+private:
+    friend class MessageArena;
+    AbstractMessage *next_ = nullptr; // Next message allocated in the same arena
 };
 
-struct Message final : CastableShared<Message, AbstractMessage> {
-    using CastableShared::CastableShared;
-    using CastableShared::get;
+/// Non-owning reference to a message. Messages are owned by the MessageArena they were created in.
+struct Message final : CastablePtr<Message, AbstractMessage> {
+    using CastablePtr::CastablePtr;
 };
 
+/// Messages received by an actor in a single tick.
+using Messages = std::span<const Message>;
+
 inline std::ostream &operator<<(std::ostream &os, const Message &message) { return os << message->to_string(); }
 
 } // namespace nvl
@@ -0,0 +1,34 @@
+#include "nvl/message/MessageArena.h"
+
+#include <cstddef>
+
+#include "nvl/macros/Assert.h"
+
+namespace nvl {
+
+void MessageArena::clear() {
+    while (head_ != nullptr) {
+        AbstractMessage *next = head_->next_;
+        std::destroy_at(head_);
+        head_ = next;
+    }
+    used_ = 0;
+    offset_ = 0;
+    size_ = 0;
+}
+
+void *MessageArena::allocate(const U64 size, const U64 align) {
+    ASSERT(size <= kBlockSize && align <= alignof(std::max_align_t), "Object is too large for arena");
+    U64 offset = (offset_ + align - 1) & ~(align - 1);
+    if (used_ == 0 || offset + size > kBlockSize) {
+        if (used_ == blocks_.size()) {
+            blocks_.emplace_back(new std::byte[kBlockSize]);
+        }
+        used_ += 1;
+        offset = 0;
+    }
+    offset_ = offset + size;
+    return blocks_[used_ - 1].get() + offset;
+}
+
+} // namespace nvl
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "nvl/data/List.h"
+#include "nvl/macros/Aliases.h"
+#include "nvl/macros/Pure.h"
+#include "nvl/message/Message.h"
+
+namespace nvl {
+
+/**
+ * @class MessageArena
+ * @brief Bump allocator for messages and other short-lived, per-tick objects.
+ *
+ * Objects are constructed in place in fixed-size blocks, so creating a message never allocates once the arena has
+ * grown to the peak number of messages per tick. Messages are linked together intrusively as they are created so
+ * that clear() can destroy them all at once. Blocks are kept across calls to clear() and reused.
+ */
+class MessageArena {
+public:
+    static constexpr U64 kBlockSize = 16 * 1024;
+
+    MessageArena() = default;
+    MessageArena(const MessageArena &) = delete;
+    MessageArena &operator=(const MessageArena &) = delete;
+    ~MessageArena() { clear(); }
+
+    /// Creates a message of type Msg from [args]. The message is valid until the next call to clear().
+    template <typename Msg, typename... Args>
+        requires std::is_base_of_v<AbstractMessage, Msg>
+    Message emplace(Args &&...args) {
+        AbstractMessage *message = new (allocate(sizeof(Msg), alignof(Msg))) Msg(std::forward<Args>(args)...);
+        message->next_ = head_;
+        head_ = message;
+        ++size_;
+        return Message(message);
+    }
+
+    /// Creates an object of type T from [args]. T is never destructed, so it must be trivially destructible.
+    template <typename T, typename... Args>
+        requires std::is_trivially_destructible_v<T>
+    T *make(Args &&...args) {
+        return new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+    }
+
+    /// Destroys all messages in this arena, keeping its blocks for reuse.
+    void clear();
+
+    /// Returns the number of messages currently in this arena.
+    pure U64 size() const { return size_; }
+
+    /// Returns the number of bytes currently reserved by this arena.
+    pure U64 capacity() const { return blocks_.size() * kBlockSize; }
+
+private:
+    void *allocate(U64 size, U64 align);
+
+    List<std::unique_ptr<std::byte[]>> blocks_;
+    U64 used_ = 0;   // Number of blocks in use; the last of these is being allocated from
+    U64 offset_ = 0; // Offset of the next free byte in the last block in use
+    U64 size_ = 0;
+    AbstractMessage *head_ = nullptr; // Most recently created message
+};
+
+} // namespace nvl
@@ -3,19 +3,11 @@
 
 namespace nvl {
 
-namespace {
-constexpr bool is_subclass(const ClassTag &a, const ClassTag &b, const bool strict = false) {
-    return_if(!strict && a == b, true);
-    for (U64 i = 0; i < ClassTag::kMaxParents && a.parents[i] != nullptr; ++i) {
-        return_if(is_subclass(*a.parents[i], b), true);
+pure bool ClassTag::is_subclass(const ClassTag &rhs) const {
+    for (U64 i = 0; i < kMaxParents && parents[i] != nullptr; ++i) {
+        return_if(*parents[i] <= rhs, true);
     }
     return false;
 }
-} // namespace
-
-pure bool ClassTag::operator<=(const ClassTag &rhs) const { return is_subclass(*this, rhs); }
-pure bool ClassTag::operator>=(const ClassTag &rhs) const { return is_subclass(rhs, *this); }
-pure bool ClassTag::operator<(const ClassTag &rhs) const { return is_subclass(*this, rhs, true); }
-pure bool ClassTag::operator>(const ClassTag &rhs) const { return is_subclass(rhs, *this, true); }
 
 } // namespace nvl
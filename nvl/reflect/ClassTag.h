@@ -5,6 +5,7 @@
 
 #include "nvl/macros/Aliases.h"
 #include "nvl/macros/Pure.h"
+#include "nvl/macros/ReturnIf.h"
 
 namespace nvl {
 
@@ -34,6 +35,7 @@ concept HasClassTag = requires(T inst) { T::_classtag; } && requires(T inst) { i
  */
 struct ClassTag {
     static constexpr U64 kMaxParents = 16;
+    static constexpr U64 kMaxDepth = 16;
 
     template <typename T>
         requires HasClassTag<T>
@@ -55,10 +57,16 @@ struct ClassTag {
 
     pure constexpr bool operator==(const ClassTag &rhs) const { return this == &rhs; }
     pure constexpr bool operator!=(const ClassTag &rhs) const { return this != &rhs; }
-    pure bool operator<=(const ClassTag &rhs) const;
-    pure bool operator>=(const ClassTag &rhs) const;
-    pure bool operator<(const ClassTag &rhs) const;
-    pure bool operator>(const ClassTag &rhs) const;
+    /// Returns true if this tag is the same as or a subclass of [rhs].
+    /// Constant time unless this class has multiple inheritance somewhere in its ancestry.
+    pure bool operator<=(const ClassTag &rhs) const {
+        return_if(this == &rhs, true);
+        return_if(rhs.depth < depth && rhs.depth < kMaxDepth && display[rhs.depth] == &rhs, true);
+        return multiple && is_subclass(rhs);
+    }
+    pure bool operator>=(const ClassTag &rhs) const { return rhs <= *this; }
+    pure bool operator<(const ClassTag &rhs) const { return this != &rhs && *this <= rhs; }
+    pure bool operator>(const ClassTag &rhs) const { return rhs < *this; }
 
     template <U64 i>
     pure constexpr ClassTag with_parents() const {
@@ -69,12 +77,34 @@ struct ClassTag {
         requires(i < kMaxParents)
     pure constexpr ClassTag with_parents() const {
         ClassTag tag = *this;
-        tag.parents[i] = &Arg::_classtag;
+        const ClassTag &parent = Arg::_classtag;
+        tag.parents[i] = &parent;
+        if (i == 0) {
+            tag.depth = parent.depth + 1;
+            tag.display = parent.display;
+            if (parent.depth < kMaxDepth) {
+                tag.display[parent.depth] = &parent;
+            } else {
+                tag.multiple = true; // Ancestors past the end of the display are found by walking the parents
+            }
+        }
+        tag.multiple = tag.multiple || parent.multiple || i > 0;
         return tag.with_parents<i + 1, Args...>();
     }
 
     std::string_view name;
     std::array<const ClassTag *, kMaxParents> parents = {nullptr};
+
+    // Ancestors along the chain of first parents, indexed by their depth, such that checking for a subclass along
+    // this chain is a single comparison (a Cohen display). Other parents are only visited if [multiple] is true.
+    // Ancestors deeper than kMaxDepth are not in the display, so classes below them also set [multiple].
+    U64 depth = 0;
+    std::array<const ClassTag *, kMaxDepth> display = {nullptr};
+    bool multiple = false;
+
+private:
+    /// Returns true if any parent of this tag is transitively a subclass of [rhs].
+    pure bool is_subclass(const ClassTag &rhs) const;
 };
 
 template <typename T>
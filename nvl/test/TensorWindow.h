@@ -16,6 +16,10 @@ public:
 
     void line_cube(const Color &, const Box<3> &) override {}
     void fill_cube(const Color &, const Box<3> &) override {}
+    void line_cubes(const Color &, std::span<const Box<3>>) override {}
+    void fill_cubes(const Color &, std::span<const Box<3>>) override {}
+    void line_faces(const Color &, std::span<const Edge<3, I64>>, const Pos<3> &) override {}
+    void fill_faces(const Color &, std::span<const Edge<3, I64>>, const Pos<3> &) override {}
 
     void line(const Color &, const Line<2> &) override {}
     void line(const Color &, const Line<3> &) override {}
@@ -3,6 +3,7 @@
 #include "nvl/macros/Unreachable.h"
 #include "nvl/ui/Color.h"
 #include "raylib.h"
+#include "rlgl.h"
 
 namespace nvl {
 
@@ -15,6 +16,88 @@ constexpr ::Color raycolor(const Color &color) {
                    .a = static_cast<U8>(color.a)};
 }
 
+// Corners of a cube are indexed by which of their coordinates are at the maximum: bit 0 for x, 1 for y, 2 for z.
+
+// clang-format off
+/// Corners of the two triangles on each face, counter-clockwise when viewed from outside (same order as DrawCube).
+constexpr U8 kCubeTriangles[36] = {
+    4, 5, 6, 7, 6, 5, // Front (+z)
+    0, 2, 1, 3, 1, 2, // Back (-z)
+    2, 6, 7, 3, 2, 7, // Top (+y)
+    0, 5, 4, 1, 5, 0, // Bottom (-y)
+    1, 3, 7, 5, 1, 7, // Right (+x)
+    0, 6, 2, 4, 6, 0, // Left (-x)
+};
+
+/// Endpoints of each of the twelve edges of a cube.
+constexpr U8 kCubeEdges[24] = {
+    0, 1, 2, 3, 4, 5, 6, 7, // Along x
+    0, 2, 1, 3, 4, 6, 5, 7, // Along y
+    0, 4, 1, 5, 2, 6, 3, 7, // Along z
+};
+// clang-format on
+
+/// Emits the vertices of each cube in [cubes], scaled by [scale], in the given [order] of corners.
+/// All cubes are emitted in a single batch with no per-cube matrix transforms, unlike DrawCube/DrawCubeWires.
+template <U64 kVertices>
+void emit_cubes(const int mode, const ::Color &color, const std::span<const Box<3>> cubes, const F64 scale,
+                const U8 (&order)[kVertices]) {
+    rlBegin(mode);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    for (const Box<3> &cube : cubes) {
+        const Vec<3> min = real(cube.min) / scale;
+        const Vec<3> end = real(cube.end) / scale;
+        Vector3 corners[8];
+        for (U64 i = 0; i < 8; ++i) {
+            corners[i].x = static_cast<float>((i & 1) ? end[0] : min[0]);
+            corners[i].y = static_cast<float>((i & 2) ? end[1] : min[1]);
+            corners[i].z = static_cast<float>((i & 4) ? end[2] : min[2]);
+        }
+        for (const U8 corner : order) {
+            rlVertex3f(corners[corner].x, corners[corner].y, corners[corner].z);
+        }
+    }
+    rlEnd();
+}
+
+/// Emits the vertices of each zero-thickness face in [faces], shifted by [offset] and scaled by [scale].
+/// Filled faces are two triangles, counter-clockwise when viewed from the side the face points towards.
+/// Outlined faces are the four sides of the rectangle.
+void emit_faces(const int mode, const ::Color &color, const std::span<const Edge<3, I64>> faces,
+                const Pos<3> &offset, const F64 scale) {
+    rlBegin(mode);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    for (const Edge<3, I64> &face : faces) {
+        // Axes (a, b, dim) are right-handed, so (a, b) is counter-clockwise when viewed from +dim
+        const U64 a = (face.dim + 1) % 3;
+        const U64 b = (face.dim + 2) % 3;
+        const Vec<3> min = real(face.box.min + offset) / scale;
+        const Vec<3> end = real(face.box.end + offset) / scale;
+        Vector3 corners[4];
+        for (U64 i = 0; i < 4; ++i) {
+            Vec<3> pt = min;
+            pt[a] = (i == 1 || i == 2) ? end[a] : min[a];
+            pt[b] = (i >= 2) ? end[b] : min[b];
+            corners[i] = Vector3{static_cast<float>(pt[0]), static_cast<float>(pt[1]), static_cast<float>(pt[2])};
+        }
+        const auto vertex = [&](const U64 i) { rlVertex3f(corners[i].x, corners[i].y, corners[i].z); };
+        if (mode == RL_LINES) {
+            for (U64 i = 0; i < 4; ++i) {
+                vertex(i);
+                vertex((i + 1) % 4);
+            }
+        } else {
+            static constexpr U64 kFront[6] = {0, 1, 2, 0, 2, 3};
+            static constexpr U64 kBack[6] = {0, 2, 1, 0, 3, 2};
+            const U64 *order = face.dir == Dir::Pos ? kFront : kBack;
+            for (U64 i = 0; i < 6; ++i) {
+                vertex(order[i]);
+            }
+        }
+    }
+    rlEnd();
+}
+
 } // namespace
 
 RayWindow::RayWindow(const std::string &title, Pos<2> shape) : Window(title, shape) {
@@ -90,26 +173,24 @@ void RayWindow::fill_box(const Color &color, const Box<2> &box) {
     DrawRectangle(box.min[0], box.min[1], shape[0], shape[1], raycolor(color));
 }
 
-void RayWindow::line_cube(const Color &color, const Box<3> &cube) {
-    const Vec<3> min = real(cube.min) / scale_;
-    const Vec<3> shape = real(cube.shape()) / scale_;
-    // Cube position is the _center_ position for raylib
-    Vector3 pos;
-    pos.x = static_cast<float>(min[0] + shape[0] / 2);
-    pos.y = static_cast<float>(min[1] + shape[1] / 2);
-    pos.z = static_cast<float>(min[2] + shape[2] / 2);
-    DrawCubeWires(pos, shape[0], shape[1], shape[2], raycolor(color));
-}
-
-void RayWindow::fill_cube(const Color &color, const Box<3> &cube) {
-    const Vec<3> min = real(cube.min) / scale_;
-    const Vec<3> shape = real(cube.shape()) / scale_;
-    // Cube position is the _center_ position for raylib
-    Vector3 pos;
-    pos.x = static_cast<float>(min[0] + shape[0] / 2);
-    pos.y = static_cast<float>(min[1] + shape[1] / 2);
-    pos.z = static_cast<float>(min[2] + shape[2] / 2);
-    DrawCube(pos, shape[0], shape[1], shape[2], raycolor(color));
+void RayWindow::line_cube(const Color &color, const Box<3> &cube) { line_cubes(color, {&cube, 1}); }
+
+void RayWindow::fill_cube(const Color &color, const Box<3> &cube) { fill_cubes(color, {&cube, 1}); }
+
+void RayWindow::line_cubes(const Color &color, const std::span<const Box<3>> cubes) {
+    emit_cubes(RL_LINES, raycolor(color), cubes, scale_, kCubeEdges);
+}
+
+void RayWindow::fill_cubes(const Color &color, const std::span<const Box<3>> cubes) {
+    emit_cubes(RL_TRIANGLES, raycolor(color), cubes, scale_, kCubeTriangles);
+}
+
+void RayWindow::line_faces(const Color &color, const std::span<const Edge<3, I64>> faces, const Pos<3> &offset) {
+    emit_faces(RL_LINES, raycolor(color), faces, offset, scale_);
+}
+
+void RayWindow::fill_faces(const Color &color, const std::span<const Edge<3, I64>> faces, const Pos<3> &offset) {
+    emit_faces(RL_TRIANGLES, raycolor(color), faces, offset, scale_);
 }
 
 void RayWindow::line(const Color &color, const Line<2> &line) {
@@ -18,6 +18,10 @@ public:
 
     void line_cube(const Color &color, const Box<3> &cube) override;
     void fill_cube(const Color &color, const Box<3> &cube) override;
+    void line_cubes(const Color &color, std::span<const Box<3>> cubes) override;
+    void fill_cubes(const Color &color, std::span<const Box<3>> cubes) override;
+    void line_faces(const Color &color, std::span<const Edge<3, I64>> faces, const Pos<3> &offset) override;
+    void fill_faces(const Color &color, std::span<const Edge<3, I64>> faces, const Pos<3> &offset) override;
 
     void line(const Color &color, const Line<2> &line) override;
     void line(const Color &color, const Line<3> &line) override;
@@ -27,4 +27,11 @@ Vec<3> View3D::project(const Vec<3> &from, const F64 length) const {
     return from + delta;
 }
 
+Frustum View3D::frustum(const F64 aspect) const {
+    // Matches the camera set up by the window: screen up is -Y, and the clipping planes are in scaled units
+    const Vec<3> eye = real(offset);
+    const Vec<3> up{0, -1, 0};
+    return Frustum(eye, project(1) - eye, up, fov, aspect, kNearClip * scale, kFarClip * scale);
+}
+
 } // namespace nvl
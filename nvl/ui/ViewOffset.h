@@ -1,5 +1,6 @@
 #pragma once
 
+#include "nvl/geo/Frustum.h"
 #include "nvl/geo/Tuple.h"
 #include "nvl/macros/Aliases.h"
 #include "nvl/macros/Unreachable.h"
@@ -31,6 +32,12 @@ struct View3D final : AbstractViewOffset {
     pure Vec<3> project(F64 length) const;
     pure Vec<3> project(const Vec<3> &from, F64 length) const;
 
+    /// Returns the volume visible from this view on a screen with the given [aspect] ratio (width / height).
+    pure Frustum frustum(F64 aspect) const;
+
+    static constexpr F64 kNearClip = 0.01; // Distance to the near clipping plane, in scaled units
+    static constexpr F64 kFarClip = 1000;  // Distance to the far clipping plane, in scaled units
+
     Pos<3> offset = Pos<3>::zero; // Location of camera, in world coordinates
     F64 pitch = 0;                // Angle between XY, between -89 and 89
     F64 angle = 0;                // Angle between XZ, between 0 and 360
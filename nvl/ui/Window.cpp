@@ -34,11 +34,36 @@ void Window::react() {
     update();
 }
 
+void Window::line_cubes(const Color &color, const std::span<const Box<3>> cubes) {
+    for (const Box<3> &cube : cubes) {
+        line_cube(color, cube);
+    }
+}
+
+void Window::fill_cubes(const Color &color, const std::span<const Box<3>> cubes) {
+    for (const Box<3> &cube : cubes) {
+        fill_cube(color, cube);
+    }
+}
+
+void Window::line_faces(const Color &color, const std::span<const Edge<3, I64>> faces, const Pos<3> &offset) {
+    for (const Edge<3, I64> &face : faces) {
+        line_cube(color, face.box + offset);
+    }
+}
+
+void Window::fill_faces(const Color &color, const std::span<const Edge<3, I64>> faces, const Pos<3> &offset) {
+    for (const Edge<3, I64> &face : faces) {
+        fill_cube(color, face.box + offset);
+    }
+}
+
 void Window::push_view(const ViewOffset &offset) {
     if (!views_.empty())
         end_view_offset(views_.back());
     views_.push_back(offset);
     set_view_offset(views_.back());
+    update_frustum();
 }
 
 void Window::pop_view() {
@@ -49,6 +74,16 @@ void Window::pop_view() {
     if (!views_.empty()) {
         set_view_offset(views_.back());
     }
+    update_frustum();
+}
+
+void Window::update_frustum() {
+    const auto *view3d = views_.empty() ? nullptr : views_.back().dyn_cast<View3D>();
+    if (view3d && height() > 0) {
+        frustum_ = view3d->frustum(static_cast<F64>(width()) / static_cast<F64>(height()));
+    } else {
+        frustum_ = None;
+    }
 }
 
 void Window::loop(const Duration &nanos_per_tick, const Duration &nanos_per_draw) {
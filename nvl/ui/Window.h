@@ -1,10 +1,12 @@
 #pragma once
 
+#include <span>
 #include <string_view>
 
 #include "Color.h"
 #include "nvl/data/List.h"
 #include "nvl/data/Set.h"
+#include "nvl/geo/Frustum.h"
 #include "nvl/geo/Line.h"
 #include "nvl/geo/Tuple.h"
 #include "nvl/geo/Volume.h"
@@ -75,11 +77,24 @@ public:
     virtual void line_cube(const Color &color, const Box<3> &cube) = 0;
     virtual void fill_cube(const Color &color, const Box<3> &cube) = 0;
 
+    /// Draws many cubes of the same color at once. Prefer this over drawing each cube separately.
+    /// By default, this draws each cube separately.
+    virtual void line_cubes(const Color &color, std::span<const Box<3>> cubes);
+    virtual void fill_cubes(const Color &color, std::span<const Box<3>> cubes);
+
+    /// Draws the outlines or front sides of zero-thickness [faces] (e.g. from BRTree::surface), shifted by [offset].
+    /// By default, this draws each face as a flat cube.
+    virtual void line_faces(const Color &color, std::span<const Edge<3, I64>> faces, const Pos<3> &offset);
+    virtual void fill_faces(const Color &color, std::span<const Edge<3, I64>> faces, const Pos<3> &offset);
+
     virtual void line(const Color &color, const Line<3> &line) = 0;
 
     void push_view(const ViewOffset &offset);
     void pop_view();
 
+    /// Returns the volume visible in the current view, in world coordinates, or nullptr if the view is not 3D.
+    pure const Frustum *frustum() const { return frustum_.has_value() ? &*frustum_ : nullptr; }
+
     virtual void set_mouse_mode(const MouseMode mode) {
         mouse_mode_ = mode;
         prev_mouse_ = None;
@@ -121,6 +136,8 @@ protected:
     virtual void set_view_offset(const ViewOffset &offset) = 0;
     virtual void end_view_offset(const ViewOffset &offset) = 0;
 
+    void update_frustum();
+
     /// Called before/after drawing all child screens.
     virtual void predraw() {}
     virtual void postdraw() {}
@@ -132,6 +149,7 @@ protected:
     Vec<2> scroll_ = Vec<2>::zero;
 
     List<ViewOffset> views_;
+    Maybe<Frustum> frustum_ = None; // Visible volume of the current 3D view
 
     MouseMode mouse_mode_ = MouseMode::kStandard;
     Color background_ = Color::kRayWhite;
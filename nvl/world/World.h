@@ -1,12 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <memory>
 #include <ranges>
 #include <utility>
+#include <vector>
 
 #include "nvl/actor/Actor.h"
 #include "nvl/actor/Part.h"
+#include "nvl/data/FlatMap.h"
+#include "nvl/data/FlatSet.h"
 #include "nvl/data/Map.h"
+#include "nvl/data/Parallel.h"
 #include "nvl/data/Set.h"
+#include "nvl/data/UnionFind.h"
 #include "nvl/entity/Entity.h"
 #include "nvl/geo/RTree.h"
 #include "nvl/geo/Volume.h"
@@ -14,6 +22,7 @@
 #include "nvl/message/Created.h"
 #include "nvl/message/Destroy.h"
 #include "nvl/message/Message.h"
+#include "nvl/message/MessageArena.h"
 #include "nvl/time/Clock.h"
 #include "nvl/time/Duration.h"
 #include "nvl/ui/Screen.h"
@@ -35,6 +44,7 @@ public:
         I64 maximum_y = 1e3;         // pixels -- down is positive
         I64 pixels_per_meter = 1000; // pixels / meter
         I64 ms_per_tick = 30;        // milliseconds / tick
+        I64 tick_threads = 1;        // threads used to tick awake entities (1 is serial)
     };
 
     static constexpr I64 kMaxEntries = 10;
@@ -57,6 +67,7 @@ public:
     const I64 kMaxVelocity;  // pixels / tick
     const Pos<N> kGravity;   // pixels / tick^2
     const I64 kMaxY;         // pixels
+    const U64 kTickThreads;  // threads used to tick awake entities
 
     pure static bool is_up(const U64 dim, const Dir dir) { return dim == kVerticalDim && dir == Dir::Neg; }
     pure static bool is_down(const U64 dim, const Dir dir) { return dim == kVerticalDim && dir == Dir::Pos; }
@@ -67,7 +78,10 @@ public:
           kGravityAccel(params.gravity_accel * kPixelsPerMeter * kMillisPerTick * kMillisPerTick / 1e6),
           kMaxVelocity(params.terminal_velocity * kMillisPerTick * kPixelsPerMeter / 1e3),
           kGravity(Pos<N>::unit(kVerticalDim, kGravityAccel)), // Gravity as a vector
-          kMaxY(params.maximum_y) {
+          kMaxY(params.maximum_y), kTickThreads(std::max<I64>(1, params.tick_threads)) {
+        if (kTickThreads > 1) {
+            pool_ = std::make_unique<ThreadPool>(kTickThreads);
+        }
 
         on_mouse_move[{Mouse::Any}] = [this] {
             propagate_event(); // Don't prevent children from seeing the mouse movement event
@@ -85,12 +99,47 @@ public:
     pure Range<Actor> entities() const { return entities_.items(); }
     pure Set<Actor> entities(const Box<N> &box) const { return entities_[box]; }
     pure Set<Actor> entities(const Pos<N> &pos) const { return entities_[pos]; }
+
+    /// Returns true if the actor is currently in this world.
+    pure bool has(const Actor &actor) const { return entities_.has(actor); }
+
+    /// Calls [func] on each actor in the given volume exactly once, without collecting them into a Set.
+    /// Stops early if [func] returns WalkResult::kExit.
+    template <typename VisitFunc> // Actor => WalkResult | void
+    void for_each_in(const Box<N> &box, VisitFunc func) const {
+        entities_.for_each_in(box, func);
+    }
+
+    /// Returns true if any actor in the given volume meets the condition [cond].
+    template <typename Cond> // Actor => bool
+    pure bool any_in(const Box<N> &box, Cond cond) const {
+        return entities_.any_in(box, cond);
+    }
+
+    /// Returns up to [k] actors nearest to [pos], ordered by increasing distance to their bounds.
+    pure List<Actor> nearest(const Pos<N> &pos, const U64 k) const { return entities_.nearest(pos, k); }
+
+    /// Returns all actors with bounds within [radius] of [pos], ordered by increasing distance.
+    pure List<Actor> within(const Pos<N> &pos, const F64 radius) const { return entities_.within(pos, radius); }
+
     pure Maybe<Actor> first_in(const Box<N> &box) const { return entities_.first(box); }
     pure Maybe<Actor> first_in(const Pos<N> &pos) const { return entities_.first(pos); }
 
     pure Maybe<Intersect> first_except(const Line<N> &line, const Actor &actor) const;
     pure Maybe<Intersect> first(const Line<N> &line) const { return first_except(line, nullptr); }
 
+    /// Groups the entities in [roots], together with all entities transitively resting on them, into islands of
+    /// entities in contact using a union-find. Entities which do not fall (e.g. the ground) are only included as
+    /// roots, so separate stacks resting on the same ground remain separate islands.
+    pure List<Set<Actor>> islands(const Range<Actor> &roots) const;
+
+    /// Wakes the island of entities currently resting on [actor] as a unit at the end of this tick.
+    void wake_above(const Actor &actor) {
+        for (const Set<Actor> &island : islands(List<Actor>{actor}.range())) {
+            woken_.insert(island.values());
+        }
+    }
+
     pure ViewOffset view() const { return view_; }
     void set_hud(const bool enable) { hud_ = enable; }
 
@@ -111,20 +160,33 @@ public:
 
     template <typename Msg, typename... Args>
     void send(Actor src, const Actor &dst, Args &&...args) {
-        const auto message = Message::get<Msg>(src.ptr(), std::forward<Args>(args)...);
         if (entities_.has(dst)) {
-            messages_[dst].push_back(std::move(message));
+            post(dst, arena().template emplace<Msg>(src.ptr(), std::forward<Args>(args)...));
         }
     }
 
+    /// Sends a single message to each distinct actor in [dst]. Returns the number of recipients.
+    /// Recipients are sorted and deduplicated once up front. Liveness is checked on delivery rather than per
+    /// recipient here: messages to actors which were removed in the meantime are dropped at the start of next tick.
     template <typename Msg, typename... Args>
-    void send(Actor src, const Range<Actor> &dst, Args &&...args) {
-        const auto message = Message::get<Msg>(src.ptr(), std::forward<Args>(args)...);
+    U64 send(Actor src, const Range<Actor> &dst, Args &&...args) {
+        recipients_.clear();
         for (const Actor &actor : dst) {
-            if (entities_.has(actor)) {
-                messages_[actor].push_back(message);
-            }
+            recipients_.push_back(actor);
         }
+        return_if(recipients_.empty(), 0);
+        const auto by_address = [](const Actor &a, const Actor &b) { return a.ptr() < b.ptr(); };
+        std::sort(recipients_.begin(), recipients_.end(), by_address);
+        recipients_.resize(std::unique(recipients_.begin(), recipients_.end()) - recipients_.begin(), nullptr);
+
+        const Message message = arena().template emplace<Msg>(src.ptr(), std::forward<Args>(args)...);
+        messages_.reserve(messages_.size() + recipients_.size());
+        for (const Actor &actor : recipients_) {
+            post(actor, message);
+        }
+        fanout_last_ += recipients_.size();
+        fanout_max_ = std::max(fanout_max_, recipients_.size());
+        return recipients_.size();
     }
 
     /// Inserts a copy of this entity into the world.
@@ -167,7 +229,31 @@ public:
 
     void set_view(const ViewOffset &view) { view_ = view; }
 
-    pure const Map<Actor, List<Message>> &messages() const { return messages_; }
+    /// Returns the number of messages waiting to be received by [actor].
+    pure U64 num_messages(const Actor &actor) const {
+        const Inbox *inbox = messages_.get(actor);
+        return inbox ? inbox->size : 0;
+    }
+
+    /// Returns the number of messages received during the last tick, and the most received in any tick.
+    pure U64 messages_last() const { return msgs_last_; }
+    pure U64 messages_max() const { return msgs_max_; }
+
+    /// Returns the number of broadcast recipients since the start of the last tick, and the most recipients of any
+    /// single broadcast.
+    pure U64 fanout_last() const { return fanout_last_; }
+    pure U64 fanout_max() const { return fanout_max_; }
+
+    /// Distribution of the number of parts per entity, e.g. to track how fragmented entities become.
+    struct PartStats {
+        U64 entities = 0;  // Number of entities
+        U64 parts = 0;     // Total number of parts across all entities
+        U64 max = 0;       // Most parts in any one entity
+        List<U64> buckets; // Number of entities with [2^(i-1), 2^i) parts in bucket i, or no parts in bucket 0
+    };
+
+    /// Returns the distribution of parts per entity. Visits every entity, so this is intended for debugging.
+    pure PartStats part_stats() const;
 
     pure U64 ticks() const { return ticks_; }
 
@@ -176,15 +262,48 @@ public:
 protected:
     using EntityHash = PointerHash<Ref<Entity<N>>, Entity<N>>;
 
-    void tick_entity(Set<Actor> &idled, Ref<Entity<N>> entity);
+    /// Delivery of a message to one recipient, linked into the recipient's inbox. Allocated in a message arena.
+    struct Envelope {
+        Message message;
+        Envelope *next;
+    };
+    /// Queue of messages for one recipient, in the order they were sent.
+    struct Inbox {
+        Envelope *head = nullptr;
+        Envelope *tail = nullptr;
+        U64 size = 0;
+    };
+
+    /// Returns the arena that messages sent now are allocated in.
+    /// Messages are always received no later than the tick after they are sent, so each arena is cleared at the
+    /// start of every second tick.
+    pure MessageArena &arena() { return arenas_[ticks_ % 2]; }
+
+    void post(const Actor &dst, const Message &message) {
+        auto *envelope = arena().template make<Envelope>(message, nullptr);
+        Inbox &inbox = messages_[dst];
+        (inbox.tail ? inbox.tail->next : inbox.head) = envelope;
+        inbox.tail = envelope;
+        inbox.size += 1;
+    }
+
+    void tick_entity(FlatSet<Actor> &idled, Ref<Entity<N>> entity);
+    void tick_parallel(FlatSet<Actor> &idled);
 
     EntityTree entities_;
-    Set<Actor> awake_;
-    Set<Actor> died_;
-    Map<Actor, List<Message>> messages_;
+    FlatSet<Actor> awake_;
+    FlatSet<Actor> died_;
+    FlatSet<Actor> woken_; // Entities to wake at the end of this tick
+    FlatSet<Actor> moved_; // Entities which have moved so far in the current parallel tick
+    FlatMap<Actor, Inbox> messages_;
+    MessageArena arenas_[2];
+    List<Message> received_; // Messages being received by the entity currently ticking
 
     ViewOffset view_ = ViewOffset::zero<N>(); // Location of the camera in world coordinates
     U64 msgs_last_ = 0, msgs_max_ = 0;        // Message queue sizes (previous tick and max)
+    U64 fanout_last_ = 0, fanout_max_ = 0;    // Broadcast recipients (previous tick and largest broadcast)
+    List<Actor> recipients_;                  // Recipients of the broadcast currently being sent
+    std::unique_ptr<ThreadPool> pool_;        // Workers used to plan velocities when ticking in parallel
     bool hud_ = true;                         // True if HUD should be drawn over world view
     bool debug_ = true;                       // True if debug should be drawn over world view
     U64 ticks_ = 0;
@@ -193,51 +312,98 @@ protected:
 template <U64 N>
 pure Maybe<typename World<N>::Intersect> World<N>::first_except(const Line<N> &line, const Actor &actor) const {
     Maybe<Intersect> closest = None;
-    for (Actor other : entities({floor(line.a()), ceil(line.b())})) {
-        if (auto *entity = other.dyn_cast<Entity<N>>(); entity && other != actor) {
-            if (auto int0 = intersect(line, entity->bbox())) {
-                if (auto int1 = entity->first(line)) {
-                    if (!closest.has_value() || int1->dist < closest->dist) {
-                        closest = Intersect(*int1, other, int1->item);
-                    }
+    entities_.walk_along(line, [&](const Actor &other) -> Maybe<F64> {
+        const auto *entity = other.dyn_cast<Entity<N>>();
+        return_if(!entity || other == actor, None);
+        const auto int1 = entity->first(line);
+        return_if(!int1.has_value(), None);
+        if (!closest.has_value() || int1->dist < closest->dist) {
+            closest = Intersect(*int1, other, int1->item);
+        }
+        return int1->dist;
+    });
+    return closest;
+}
+
+template <U64 N>
+List<Set<Actor>> World<N>::islands(const Range<Actor> &roots) const {
+    UnionFind<Actor> islands;
+    List<Actor> worklist;
+    for (const Actor &root : roots) {
+        if (entities_.has(root) && root.isa<Entity<N>>() && !islands.has(root)) {
+            islands.add(root);
+            worklist.push_back(root);
+        }
+    }
+    while (!worklist.empty()) {
+        const Actor actor = worklist.back();
+        worklist.pop_back();
+        for (const Actor &above : actor.dyn_cast<Entity<N>>()->above()) {
+            if (above.dyn_cast<Entity<N>>()->falls()) {
+                if (!islands.has(above)) {
+                    worklist.push_back(above);
                 }
+                islands.add(actor, above);
             }
         }
     }
-    return closest;
+    List<Set<Actor>> result;
+    for (const Set<Actor> &island : islands.sets()) {
+        result.push_back(island);
+    }
+    return result;
 }
 
 template <U64 N>
 void World<N>::tick() {
     msgs_last_ = 0;
+    fanout_last_ = 0;
     ticks_ += 1;
+    // All messages sent two ticks ago have been received by now
+    arena().clear();
 
     // Wake any entities with pending messages
-    for (const Actor &actor : messages_.keys()) {
-        if (entities_.has(actor)) {
+    List<Actor> unticked;
+    for (const auto &[actor, _] : messages_) {
+        if (!entities_.has(actor)) {
+            died_.insert(actor);
+        } else if (actor.template dyn_cast<Entity<N>>()) {
             awake_.emplace(actor);
         } else {
-            died_.insert(actor);
+            unticked.push_back(actor);
         }
     }
+    // Actors which are never ticked would otherwise keep messages past the lifetime of their arena
+    messages_.remove(unticked.range());
 
     awake_.remove(died_.values());
     entities_.remove(died_.values());
     messages_.remove(died_.values());
     died_.clear();
 
-    Set<Actor> idled;
-    for (Actor actor : awake_) {
-        if (entities_.has(actor)) {
-            if (auto *entity = actor.dyn_cast<Entity<N>>()) {
-                tick_entity(idled, Ref(entity));
+    FlatSet<Actor> idled;
+    if (kTickThreads > 1) {
+        tick_parallel(idled);
+    } else {
+        // Iterate over a copy, since entities spawned while ticking are added to the (flat) awake set
+        const List<Actor> awake(awake_.values());
+        for (Actor actor : awake) {
+            if (entities_.has(actor)) {
+                if (auto *entity = actor.dyn_cast<Entity<N>>()) {
+                    tick_entity(idled, Ref(entity));
+                }
+            } else {
+                idled.insert(actor);
             }
-        } else {
-            idled.insert(actor);
         }
     }
 
     awake_.remove(idled.values());
+
+    // Wake entire islands at once rather than one entity per tick as each support starts moving
+    awake_.insert(woken_);
+    woken_.clear();
+
     msgs_max_ = std::max(msgs_max_, msgs_last_);
 }
 
@@ -246,13 +412,14 @@ void World<N>::draw() {
     window_->push_view(view_);
     if constexpr (N == 2) {
         const auto range = window_to_world(window_->bbox());
-        for (const Actor &actor : entities(range)) {
-            actor->draw(window_, Color::kNormal);
-        }
+        for_each_in(range, [&](const Actor &actor) { actor->draw(window_, Color::kNormal); });
     } else if constexpr (N == 3) {
-        // TODO: Restrict to only visible entities
-        for (const Actor &actor : entities_) {
-            actor->draw(window_, Color::kNormal);
+        if (const Frustum *frustum = window_->frustum()) {
+            entities_.for_each_overlapping(*frustum, [&](const Actor &actor) { actor->draw(window_, Color::kNormal); });
+        } else {
+            for (const Actor &actor : entities_) {
+                actor->draw(window_, Color::kNormal);
+            }
         }
     }
     window_->pop_view();
@@ -268,25 +435,40 @@ void World<N>::draw() {
 }
 
 template <U64 N>
-void World<N>::tick_entity(Set<Actor> &idled, Ref<Entity<N>> entity) {
-    static const List<Message> kNoMessages = {};
-
+void World<N>::tick_entity(FlatSet<Actor> &idled, Ref<Entity<N>> entity) {
     const Actor actor = entity->self();
     const Box<N> prev_bbox = entity->bbox();
-    const auto messages_iter = messages_.find(actor);
-    // Making a copy here to allow clearing the action queue early (prior to running tick)
-    const List<Message> messages = messages_iter == messages_.end() ? kNoMessages : messages_iter->second;
-    if (messages_iter != messages_.end()) {
-        messages_.erase(messages_iter);
+    // Gather the messages to allow clearing the inbox early (prior to running tick)
+    received_.clear();
+    if (const auto iter = messages_.find(actor); iter != messages_.end()) {
+        for (const Envelope *envelope = iter->second.head; envelope != nullptr; envelope = envelope->next) {
+            received_.push_back(envelope->message);
+        }
+        messages_.erase(iter);
+    }
+    msgs_last_ += received_.size();
+    // The plan only saw the world at the start of the tick, so it is stale if an entity which already moved this
+    // tick is now in its path
+    if (const Maybe<Box<N>> swept = entity->planned_sweep()) {
+        bool blocked = false;
+        entities_.for_each_in(*swept, [&](const Actor &other) { blocked = blocked || moved_.has(other); });
+        if (blocked) {
+            entity->discard_plan();
+        }
     }
-    msgs_last_ += messages.size();
-    const Status status = entity->tick(messages);
+    const Status status = entity->tick(received_);
     if (status == Status::kDied) {
         remove(actor);
-    } else if (status == Status::kIdle) {
-        idled.insert(actor);
-    } else if (status == Status::kMove) {
-        entities_.move(actor, prev_bbox);
+    } else {
+        if (status == Status::kIdle) {
+            idled.insert(actor);
+        } else if (status == Status::kMove && pool_) {
+            moved_.insert(actor);
+        }
+        // The entity tree filters queries by stored boxes, so shape changes (e.g. from hits) must be registered too
+        if (status == Status::kMove || entity->bbox() != prev_bbox) {
+            entities_.move(actor, prev_bbox);
+        }
     }
 
     // Check if the entity is now above the maximum Y limits (down is positive)
@@ -295,6 +477,69 @@ void World<N>::tick_entity(Set<Actor> &idled, Ref<Entity<N>> entity) {
     }
 }
 
+/// Ticks all awake entities in two phases:
+///   1. Plans velocities of entities without pending messages concurrently, against the unmodified world.
+///   2. Ticks each entity serially, ordered by location, applying moves, removals, and message sends.
+///      A planned velocity is discarded and recomputed if an entity which moved earlier in this phase is now in
+///      its path, since the plan did not account for that move.
+/// Every planned velocity sees the world as it was at the start of the tick, so the result does not depend on
+/// the number of threads or on the iteration order of the awake set.
+template <U64 N>
+void World<N>::tick_parallel(FlatSet<Actor> &idled) {
+    std::vector<Ref<Entity<N>>> ticking;
+    for (Actor actor : awake_) {
+        if (entities_.has(actor)) {
+            if (auto *entity = actor.dyn_cast<Entity<N>>()) {
+                ticking.emplace_back(entity);
+            }
+        } else {
+            idled.insert(actor);
+        }
+    }
+    std::sort(ticking.begin(), ticking.end(), [](const Ref<Entity<N>> &a, const Ref<Entity<N>> &b) {
+        const Box<N> box_a = a->bbox();
+        const Box<N> box_b = b->bbox();
+        for (U64 i = 0; i < N; ++i) {
+            return_if(box_a.min[i] != box_b.min[i], box_a.min[i] < box_b.min[i]);
+        }
+        for (U64 i = 0; i < N; ++i) {
+            return_if(box_a.end[i] != box_b.end[i], box_a.end[i] < box_b.end[i]);
+        }
+        return a.ptr() < b.ptr();
+    });
+
+    pool_->parallel_for(ticking.size(), [&](const U64 i) {
+        if (!messages_.has(ticking[i]->self())) {
+            ticking[i]->plan_velocity();
+        }
+    });
+
+    moved_.clear();
+    for (const Ref<Entity<N>> &entity : ticking) {
+        tick_entity(idled, entity);
+    }
+    moved_.clear();
+}
+
+template <U64 N>
+typename World<N>::PartStats World<N>::part_stats() const {
+    PartStats stats;
+    for (const Actor &actor : entities_) {
+        if (const auto *entity = actor.dyn_cast<Entity<N>>()) {
+            const U64 parts = entity->num_parts();
+            const U64 bucket = std::bit_width(parts);
+            if (stats.buckets.size() <= bucket) {
+                stats.buckets.resize(bucket + 1, 0);
+            }
+            stats.buckets[bucket] += 1;
+            stats.entities += 1;
+            stats.parts += parts;
+            stats.max = std::max(stats.max, parts);
+        }
+    }
+    return stats;
+}
+
 template <U64 N>
 void World<N>::remove(const Actor &actor) {
     died_.insert(actor);
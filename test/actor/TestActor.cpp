@@ -12,6 +12,7 @@ using nvl::Box;
 using nvl::Color;
 using nvl::List;
 using nvl::Message;
+using nvl::Messages;
 using nvl::Status;
 using nvl::Window;
 
@@ -19,7 +20,7 @@ struct SimpleActor final : AbstractActor {
     class_tag(SimpleActor, AbstractActor);
     explicit SimpleActor(const Box<2> &box) : box_(box) {}
 
-    Status tick(const List<Message> &) override { return Status::kNone; }
+    Status tick(Messages) override { return Status::kNone; }
     void draw(Window *, const Color &) const override {}
 
     Box<2> box_;
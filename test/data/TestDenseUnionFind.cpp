@@ -0,0 +1,60 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "nvl/data/DenseUnionFind.h"
+#include "nvl/data/List.h"
+
+namespace {
+
+using testing::UnorderedElementsAre;
+
+using nvl::DenseUnionFind;
+using nvl::List;
+
+List<List<U64>> groups(const DenseUnionFind &sets) {
+    List<List<U64>> groups;
+    for (const auto &set : sets.sets()) {
+        groups.emplace_back(set.begin(), set.end());
+    }
+    return groups;
+}
+
+TEST(TestDenseUnionFind, basic) {
+    DenseUnionFind sets(8);
+    EXPECT_EQ(sets.num_sets(), 8);
+    EXPECT_TRUE(sets.merge(0, 2));
+    EXPECT_TRUE(sets.merge(4, 5));
+    EXPECT_TRUE(sets.merge(0, 1));
+    EXPECT_TRUE(sets.merge(6, 7));
+    EXPECT_FALSE(sets.merge(1, 2));
+    EXPECT_EQ(sets.num_sets(), 4);
+    EXPECT_TRUE(sets.same(1, 2));
+    EXPECT_FALSE(sets.same(1, 3));
+    EXPECT_THAT(groups(sets),
+                UnorderedElementsAre(List<U64>{0, 1, 2}, List<U64>{3}, List<U64>{4, 5}, List<U64>{6, 7}));
+}
+
+TEST(TestDenseUnionFind, add) {
+    DenseUnionFind sets;
+    EXPECT_THAT(groups(sets), testing::IsEmpty());
+    const U64 a = sets.add();
+    const U64 b = sets.add();
+    EXPECT_THAT(groups(sets), UnorderedElementsAre(List<U64>{a}, List<U64>{b}));
+    sets.merge(a, b);
+    const U64 c = sets.add();
+    EXPECT_EQ(sets.size(), 3);
+    EXPECT_THAT(groups(sets), UnorderedElementsAre(List<U64>{a, b}, List<U64>{c}));
+}
+
+TEST(TestDenseUnionFind, chain) {
+    constexpr U64 n = 10000;
+    DenseUnionFind sets(n);
+    for (U64 i = 1; i < n; ++i) {
+        sets.merge(i - 1, i);
+    }
+    EXPECT_EQ(sets.num_sets(), 1);
+    ASSERT_EQ(sets.sets().size(), 1);
+    EXPECT_EQ(sets.sets().front().size(), n);
+}
+
+} // namespace
@@ -0,0 +1,69 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "nvl/data/IterRange.h"
+#include "nvl/data/List.h"
+#include "nvl/geo/Tuple.h"
+#include "nvl/geo/Volume.h"
+#include "nvl/time/Clock.h"
+#include "nvl/time/Duration.h"
+
+namespace {
+
+using testing::ElementsAre;
+
+using nvl::Box;
+using nvl::IterRange;
+using nvl::List;
+using nvl::Pos;
+using nvl::Range;
+
+TEST(TestIterRange, basic) {
+    const List<I64> list{1, 2, 3};
+    const IterRange range(list.begin(), list.end());
+    EXPECT_FALSE(range.empty());
+    EXPECT_EQ(range.size(), 3);
+    EXPECT_TRUE(range.all([](const I64 x) { return x > 0; }));
+    EXPECT_TRUE(range.exists([](const I64 x) { return x == 2; }));
+    EXPECT_THAT(range, ElementsAre(1, 2, 3));
+
+    std::stringstream ss;
+    ss << range;
+    EXPECT_EQ(ss.str(), "{1, 2, 3}");
+}
+
+TEST(TestIterRange, to_range) {
+    const Box<2> box({0, 0}, {2, 2});
+    const Range<Pos<2>> range = box.indices();
+    EXPECT_THAT(range, ElementsAre(Pos<2>(0, 0), Pos<2>(0, 1), Pos<2>(1, 0), Pos<2>(1, 1)));
+    EXPECT_EQ(range.size(), 4);
+}
+
+// Compares iteration over a List through a type-erased Range against the List's own iterators.
+// Current best is ~5.1ms (Range) vs. ~0.8ms (List) for 1M elements.
+TEST(TestIterRange, profile) {
+    List<I64> list;
+    for (I64 i = 0; i < 1'000'000; ++i) {
+        list.push_back(i);
+    }
+
+    const auto range_start = nvl::Clock::now();
+    I64 range_sum = 0;
+    for (const I64 x : list.range()) {
+        range_sum += x;
+    }
+    const auto range_end = nvl::Clock::now();
+    I64 list_sum = 0;
+    for (const I64 x : list) {
+        list_sum += x;
+    }
+    const auto list_end = nvl::Clock::now();
+
+    std::cout << "Range: " << nvl::Duration(range_end - range_start) << std::endl;
+    std::cout << "List:  " << nvl::Duration(list_end - range_end) << std::endl;
+    EXPECT_EQ(range_sum, list_sum);
+}
+
+} // namespace
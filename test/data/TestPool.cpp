@@ -0,0 +1,56 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "nvl/data/Pool.h"
+
+namespace {
+
+using nvl::List;
+using nvl::Pool;
+
+TEST(TestPool, alloc) {
+    Pool<U64, /*kSlabSize*/ 4> pool;
+    for (U32 i = 0; i < 10; ++i) {
+        const U32 index = pool.alloc();
+        EXPECT_EQ(index, i);
+        pool[index] = i * 10;
+    }
+    EXPECT_EQ(pool.size(), 10);
+    EXPECT_EQ(pool.capacity(), 10);
+    for (U32 i = 0; i < 10; ++i) {
+        EXPECT_EQ(pool[i], i * 10);
+    }
+}
+
+TEST(TestPool, stable_addresses) {
+    Pool<U64, /*kSlabSize*/ 2> pool;
+    const U32 first = pool.alloc();
+    const U64 *ptr = &pool[first];
+    for (U32 i = 0; i < 100; ++i) {
+        (void)pool.alloc();
+    }
+    EXPECT_EQ(ptr, &pool[first]);
+}
+
+TEST(TestPool, reuse) {
+    Pool<List<U64>> pool;
+    const U32 a = pool.alloc();
+    const U32 b = pool.alloc();
+    pool[a].push_back(1);
+    pool.release(a);
+    EXPECT_EQ(pool.size(), 1);
+
+    // Released slots are reused before new slots are allocated. Objects are not reset on release.
+    const U32 c = pool.alloc();
+    EXPECT_EQ(c, a);
+    EXPECT_EQ(pool[c].size(), 1);
+    EXPECT_EQ(pool.capacity(), 2);
+
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.alloc(), a);
+    EXPECT_EQ(pool.alloc(), b);
+    EXPECT_EQ(pool.capacity(), 2);
+}
+
+} // namespace
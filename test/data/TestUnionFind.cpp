@@ -19,4 +19,18 @@ TEST(TestUnionFind, basic) {
     EXPECT_THAT(sets.sets(), UnorderedElementsAre(Set<U64>{0, 1, 2}, Set<U64>{4, 5}, Set<U64>{6, 7}));
 }
 
+TEST(TestUnionFind, singletons) {
+    UnionFind<U64> sets;
+    sets.add(3);
+    sets.add(1, 2);
+    sets.add(3);
+    EXPECT_TRUE(sets.has(3));
+    EXPECT_FALSE(sets.has(4));
+    EXPECT_EQ(sets.num_sets(), 2);
+    EXPECT_THAT(sets.sets(), UnorderedElementsAre(Set<U64>{3}, Set<U64>{1, 2}));
+    sets.add(2, 3);
+    EXPECT_EQ(sets.num_sets(), 1);
+    EXPECT_THAT(sets.sets(), UnorderedElementsAre(Set<U64>{1, 2, 3}));
+}
+
 } // namespace
\ No newline at end of file
@@ -4,13 +4,16 @@
 #include "nvl/entity/Entity.h"
 #include "nvl/geo/Tuple.h"
 #include "nvl/geo/Volume.h"
+#include "nvl/material/Bulwark.h"
 #include "nvl/material/TestMaterial.h"
 #include "nvl/message/Hit.h"
+#include "nvl/message/MessageArena.h"
 #include "nvl/test/Fuzzing.h"
 
 namespace {
 
 using nvl::Block;
+using nvl::Bulwark;
 using nvl::Box;
 using nvl::Color;
 using nvl::Distribution;
@@ -53,8 +56,9 @@ Set<Box<2>> hit(const Pos<2> &box_loc, const Pos<2> &box_shape, const Pos<2> &hi
 
     const auto material = Material::get<TestMaterial>(Color::kBlue);
     auto block = world.spawn<Block<2>>(box_loc, box_shape, material);
-    auto hit = Message::get<Hit<2>>(nullptr, Box<2>(hit_loc, hit_loc + hit_shape), material->durability);
-    block->tick({hit});
+    nvl::MessageArena arena;
+    auto hit = arena.emplace<Hit<2>>(nullptr, Box<2>(hit_loc, hit_loc + hit_shape), material->durability);
+    block->tick(List<Message>{hit});
     return boxes(world);
 }
 
@@ -73,6 +77,40 @@ TEST(TestBlock, hit_block0) {
     EXPECT_EQ(actual, expected);
 }
 
+TEST(TestBlock, coalesce_after_hits) {
+    World<2>::Params params;
+    params.maximum_y = 5000;
+    params.gravity_accel = 0;
+    World<2> world(nullptr, params);
+
+    const auto material = Material::get<Bulwark>(Color::kBlue);
+    auto block = world.spawn<Block<2>>(Pos<2>{0, 0}, Pos<2>{100, 100}, material);
+
+    // Chip away at every cell of a 10x10 grid in turn, which would otherwise leave a staircase of split parts
+    nvl::MessageArena arena;
+    U64 max_parts = 0;
+    for (I64 i = 0; i < 10; ++i) {
+        for (I64 j = 0; j < 10; ++j) {
+            const Box<2> cell({i * 10, j * 10}, {i * 10 + 10, j * 10 + 10});
+            block->tick(List<Message>{arena.emplace<Hit<2>>(nullptr, cell, 1)});
+            max_parts = std::max(max_parts, block->num_parts());
+        }
+    }
+    EXPECT_LE(max_parts, 32);
+
+    I64 area = 0;
+    for (const auto &part : block->parts()) {
+        EXPECT_EQ(part->health, material->durability - 1);
+        area += part->bbox().shape().product();
+    }
+    EXPECT_EQ(area, 100 * 100);
+
+    const auto stats = world.part_stats();
+    EXPECT_EQ(stats.entities, 1);
+    EXPECT_EQ(stats.parts, block->num_parts());
+    EXPECT_EQ(stats.max, block->num_parts());
+}
+
 struct FuzzHitBlock : nvl::test::FuzzingTestFixture<Set<Box<2>>, Pos<2>, Pos<2>, Pos<2>, Pos<2>> {};
 
 TEST_F(FuzzHitBlock, hit_block2d) {
@@ -7,14 +7,18 @@
 #include "nvl/material/TestMaterial.h"
 #include "nvl/message/Hit.h"
 #include "nvl/test/Fuzzing.h"
+#include "nvl/test/NullWindow.h"
+#include "nvl/world/World.h"
 
 namespace {
 
 using nvl::Block;
 using nvl::Box;
 using nvl::Color;
+using nvl::Dir;
 using nvl::Distribution;
 using nvl::Entity;
+using nvl::Face;
 using nvl::Hit;
 using nvl::List;
 using nvl::Material;
@@ -25,6 +29,8 @@ using nvl::Set;
 using nvl::Status;
 using nvl::TestMaterial;
 using nvl::Window;
+using nvl::World;
+using nvl::test::NullWindow;
 
 struct SimpleEntity final : Entity<2> {
     using Entity::Entity;
@@ -37,4 +43,35 @@ TEST(TestEntity, construct) {
     entity.tick({});
 }
 
+TEST(TestEntity, sweep_diagonal) {
+    NullWindow window;
+    World<2> world(&window);
+    const auto material = Material::get<TestMaterial>(Color::kBlack);
+    const auto *block = world.spawn<Block<2>>(Pos<2>::zero, Box<2>({0, 0}, {10, 10}), material);
+    world.spawn<Block<2>>(Pos<2>::zero, Box<2>({15, 15}, {25, 25}), material);
+    // Moving along either axis alone is clear of the other block, but moving along the diagonal is not
+    const auto sweep = block->sweep({20, 20});
+    EXPECT_EQ(sweep.delta, Pos<2>(5, 20));
+    ASSERT_EQ(sweep.contacts.size(), 1);
+    EXPECT_EQ(sweep.contacts[0], Face(Dir::Pos, 0));
+}
+
+TEST(TestEntity, sweep_slide) {
+    NullWindow window;
+    World<2> world(&window);
+    const auto material = Material::get<TestMaterial>(Color::kBlack);
+    const auto *block = world.spawn<Block<2>>(Pos<2>::zero, Box<2>({0, 0}, {10, 10}), material);
+    world.spawn<Block<2>>(Pos<2>::zero, Box<2>({-50, 12}, {50, 20}), material);
+    world.spawn<Block<2>>(Pos<2>::zero, Box<2>({13, -50}, {20, 12}), material);
+    // Lands on the floor first, then slides along it until reaching the wall
+    const auto sweep = block->sweep({30, 30});
+    EXPECT_EQ(sweep.delta, Pos<2>(3, 2));
+    ASSERT_EQ(sweep.contacts.size(), 2);
+    EXPECT_EQ(sweep.contacts[0], Face(Dir::Pos, 1));
+    EXPECT_EQ(sweep.contacts[1], Face(Dir::Pos, 0));
+
+    // Moving only along the floor is not blocked by it
+    EXPECT_EQ(block->sweep({-20, 0}).delta, Pos<2>(-20, 0));
+}
+
 } // namespace
@@ -87,4 +87,100 @@ TEST(TestBRTree, edges) {
     EXPECT_EQ(edges0, box_edges);
 }
 
+TEST(TestBRTree, incremental_edges) {
+    BRTree<2, Box<2>> tree;
+    const auto a = tree.emplace(Pos<2>{0, 0}, Pos<2>{10, 10});
+    EXPECT_EQ(tree.edge_rtree().size(), 4);
+
+    // Adjacent box removes part of a's right edge
+    const auto b = tree.emplace(Pos<2>{10, 2}, Pos<2>{20, 5});
+    EXPECT_TRUE(tree.check_edges());
+    const bool right_of_a = tree.edge_rtree().any_in(Box<2>({10, 3}, {11, 4}), [](const Rel<Edge<2, I64>> &edge) {
+        return edge->dim == 0 && edge->dir == nvl::Dir::Pos;
+    });
+    EXPECT_FALSE(right_of_a);
+
+    tree.remove(a);
+    EXPECT_TRUE(tree.check_edges());
+    tree.remove(b);
+    EXPECT_TRUE(tree.check_edges());
+    EXPECT_EQ(tree.edge_rtree().size(), 0);
+}
+
+TEST(TestBRTree, surface) {
+    using Edge = Edge<3, I64>;
+    BRTree<3, Box<3>> tree;
+    // A 4x4 floor of unit parts has one merged face on each side
+    for (I64 x = 0; x < 4; ++x) {
+        for (I64 z = 0; z < 4; ++z) {
+            tree.emplace(Pos<3>{x, 0, z}, Pos<3>{x + 1, 1, z + 1});
+        }
+    }
+    const Box<3> floor({0, 0, 0}, {4, 1, 4});
+    EXPECT_THAT(tree.surface(), UnorderedElementsAre(Edge(nvl::Dir::Neg, 0, Box<3>({0, 0, 0}, {0, 1, 4})),
+                                                     Edge(nvl::Dir::Pos, 0, Box<3>({4, 0, 0}, {4, 1, 4})),
+                                                     Edge(nvl::Dir::Neg, 1, Box<3>({0, 0, 0}, {4, 0, 4})),
+                                                     Edge(nvl::Dir::Pos, 1, Box<3>({0, 1, 0}, {4, 1, 4})),
+                                                     Edge(nvl::Dir::Neg, 2, Box<3>({0, 0, 0}, {4, 1, 0})),
+                                                     Edge(nvl::Dir::Pos, 2, Box<3>({0, 0, 4}, {4, 1, 4}))));
+    for (const Edge &face : tree.surface()) {
+        EXPECT_EQ(nvl::bounding_box(floor, face.box), floor);
+    }
+
+    // Moving the tree does not change the (relative) surface
+    const Edge *prev = &tree.surface().front();
+    tree.loc = {100, 100, 100};
+    EXPECT_EQ(&tree.surface().front(), prev);
+
+    // Adding a part on top changes the surface
+    tree.emplace(Pos<3>{1, 1, 1}, Pos<3>{2, 2, 2});
+    // The floor's other sides, the top of the floor split into four faces around the part, and the part's sides
+    EXPECT_EQ(tree.surface().size(), 5 + 4 + 5);
+}
+
+TEST(TestBRTree, fuzz_surface) {
+    BRTree<3, Box<3>> tree;
+    nvl::Random random(0x5EF);
+    for (I64 i = 0; i < 100; ++i) {
+        const Pos<3> min = random.uniform<Pos<3>, I64>(0, 10);
+        const Pos<3> shape = random.uniform<Pos<3>, I64>(1, 4);
+        tree.emplace(min, min + shape);
+
+        // Merged faces must cover exactly the same area as the unmerged edges
+        I64 edge_area = 0;
+        for (const Rel<Edge<3, I64>> &edge : tree.edges()) {
+            edge_area += edge->box.shape().with(edge->dim, 1).product();
+        }
+        I64 surface_area = 0;
+        for (const Edge<3, I64> &face : tree.surface()) {
+            EXPECT_EQ(face.box.shape()[face.dim], 0);
+            surface_area += face.box.shape().with(face.dim, 1).product();
+        }
+        ASSERT_EQ(surface_area, edge_area) << "After insertion #" << i;
+        ASSERT_LE(tree.surface().size(), tree.edge_rtree().size());
+    }
+}
+
+TEST(TestBRTree, fuzz_incremental_edges) {
+    BRTree<2, Box<2>> tree;
+    List<Rel<Box<2>>> items;
+    nvl::Random random(0xED6E);
+    for (I64 i = 0; i < 300; ++i) {
+        if (items.empty() || random.uniform<I64, I64>(0, 2) != 0) {
+            const Pos<2> min = random.uniform<Pos<2>, I64>(0, 40);
+            const Pos<2> shape = random.uniform<Pos<2>, I64>(1, 8);
+            items.push_back(tree.emplace(min, min + shape));
+        } else {
+            const U64 index = random.uniform<U64, U64>(0, items.size() - 1);
+            tree.remove(items[index]);
+            items[index] = items.back();
+            items.pop_back();
+        }
+        // Query the edges every few updates so that several dirty regions are sometimes merged at once
+        if (i % 3 == 0) {
+            ASSERT_TRUE(tree.check_edges()) << "After update #" << i;
+        }
+    }
+}
+
 } // namespace
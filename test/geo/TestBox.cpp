@@ -256,7 +256,7 @@ struct FuzzBoxDiff : nvl::test::FuzzingTestFixture<List<Box<N>>, Box<N>, Box<N>>
                                                       << "  Resulted in more remainders than expected.");
 
             // Confirm that all points in `a` are in the remainder boxes unless they are also in b
-            const auto remainders = nvl::Range(diff.begin(), diff.end());
+            const auto remainders = diff.range();
             for (const Pos<N> &pt : a.indices()) {
                 if (b.contains(pt)) {
                     for (const auto &d : diff) {
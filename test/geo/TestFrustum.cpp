@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+
+#include "nvl/geo/Frustum.h"
+#include "nvl/geo/Tuple.h"
+#include "nvl/geo/Volume.h"
+#include "nvl/ui/ViewOffset.h"
+
+namespace {
+
+using nvl::Box;
+using nvl::Frustum;
+using nvl::Pos;
+using nvl::Vec;
+using nvl::View3D;
+
+/// Camera at the origin looking along +X with a 90 degree square field of view, seeing up to 100 units away.
+const Frustum kFrustum(Vec<3>::zero, Vec<3>{1, 0, 0}, Vec<3>{0, -1, 0}, /*fovy*/ 90, /*aspect*/ 1, 1, 100);
+
+TEST(TestFrustum, contains) {
+    EXPECT_TRUE(kFrustum.contains(Vec<3>{50, 0, 0}));
+    EXPECT_TRUE(kFrustum.contains(Vec<3>{50, 49, -49}));
+    EXPECT_FALSE(kFrustum.contains(Vec<3>{50, 51, 0}));  // Below
+    EXPECT_FALSE(kFrustum.contains(Vec<3>{50, 0, -51})); // To the side
+    EXPECT_FALSE(kFrustum.contains(Vec<3>{-1, 0, 0}));   // Behind
+    EXPECT_FALSE(kFrustum.contains(Vec<3>{0.5, 0, 0}));  // Before the near plane
+    EXPECT_FALSE(kFrustum.contains(Vec<3>{101, 0, 0}));  // Beyond the far plane
+}
+
+TEST(TestFrustum, overlaps) {
+    EXPECT_TRUE(kFrustum.overlaps(Box<3>({10, -1, -1}, {12, 1, 1})));
+    EXPECT_TRUE(kFrustum.overlaps(Box<3>({-10, -10, -10}, {10, 10, 10}))); // Contains the eye
+    EXPECT_TRUE(kFrustum.overlaps(Box<3>({90, -200, -200}, {95, 200, 200}))); // Larger than the view
+    EXPECT_TRUE(kFrustum.overlaps(Box<3>({20, 15, 15}, {30, 30, 30})));     // Partially visible corner
+    EXPECT_FALSE(kFrustum.overlaps(Box<3>({-20, -1, -1}, {-10, 1, 1})));   // Behind
+    EXPECT_FALSE(kFrustum.overlaps(Box<3>({10, 20, -1}, {12, 30, 1})));    // Below
+    EXPECT_FALSE(kFrustum.overlaps(Box<3>({10, -1, 20}, {12, 1, 30})));    // To the side
+    EXPECT_FALSE(kFrustum.overlaps(Box<3>({200, -1, -1}, {210, 1, 1})));   // Too far away
+}
+
+TEST(TestFrustum, shifted) {
+    const Frustum shifted = kFrustum - Pos<3>(100, 0, 0);
+    EXPECT_TRUE(shifted.contains(Vec<3>{-50, 0, 0}));
+    EXPECT_FALSE(shifted.contains(Vec<3>{50, 0, 0}));
+    EXPECT_TRUE(shifted.overlaps(Box<3>({-60, -1, -1}, {-50, 1, 1})));
+}
+
+TEST(TestFrustum, view3d) {
+    View3D view(Pos<3>(0, -10, 0));
+    view.angle = 90; // Looking along +Z
+    view.scale = 10;
+    const Frustum frustum = view.frustum(/*aspect*/ 16.0 / 9.0);
+    EXPECT_TRUE(frustum.contains(Vec<3>{0, -10, 100}));
+    EXPECT_TRUE(frustum.contains(Vec<3>{0, -10, View3D::kFarClip * view.scale - 1}));
+    EXPECT_FALSE(frustum.contains(Vec<3>{0, -10, View3D::kFarClip * view.scale + 1}));
+    EXPECT_FALSE(frustum.contains(Vec<3>{0, -10, -100}));
+    EXPECT_FALSE(frustum.contains(Vec<3>{100, -10, 10}));
+}
+
+} // namespace
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "nvl/geo/Merge.h"
+#include "nvl/geo/Tuple.h"
+#include "nvl/geo/Volume.h"
+#include "nvl/math/Random.h"
+
+namespace {
+
+using nvl::Box;
+using nvl::List;
+using nvl::Pos;
+
+struct Colored {
+    Box<2> box;
+    I64 color;
+};
+
+List<Colored> merge(const List<Colored> &values) {
+    return nvl::merge_adjacent<2>(values, [](const Colored &value) { return value.color; });
+}
+
+I64 area(const List<Colored> &values) {
+    I64 area = 0;
+    for (const Colored &value : values) {
+        area += value.box.shape().product();
+    }
+    return area;
+}
+
+TEST(TestMerge, grid) {
+    List<Colored> values;
+    for (I64 i = 0; i < 4; ++i) {
+        for (I64 j = 0; j < 3; ++j) {
+            values.push_back({Box<2>({i, j}, {i + 1, j + 1}), 0});
+        }
+    }
+    const List<Colored> merged = merge(values);
+    ASSERT_EQ(merged.size(), 1);
+    EXPECT_EQ(merged[0].box, Box<2>({0, 0}, {4, 3}));
+}
+
+TEST(TestMerge, groups) {
+    // Two adjacent boxes with different colors are kept separate
+    const List<Colored> merged = merge({{Box<2>({0, 0}, {1, 1}), 0}, {Box<2>({1, 0}, {2, 1}), 1}});
+    EXPECT_EQ(merged.size(), 2);
+}
+
+TEST(TestMerge, mismatched) {
+    // Adjacent boxes with different extents along the other axis are kept separate
+    const List<Colored> merged = merge({{Box<2>({0, 0}, {1, 2}), 0}, {Box<2>({1, 0}, {2, 1}), 0}});
+    EXPECT_EQ(merged.size(), 2);
+}
+
+TEST(TestMerge, fuzz) {
+    nvl::Random random(0xC0A1);
+    for (U64 test = 0; test < 100; ++test) {
+        // Random two-colored grid of unit boxes, with some holes
+        List<Colored> values;
+        for (I64 i = 0; i < 10; ++i) {
+            for (I64 j = 0; j < 10; ++j) {
+                const I64 color = random.uniform<I64>(0, 3);
+                if (color < 2) {
+                    values.push_back({Box<2>({i, j}, {i + 1, j + 1}), color});
+                }
+            }
+        }
+        const List<Colored> merged = merge(values);
+        ASSERT_LE(merged.size(), values.size());
+        for (I64 color = 0; color < 2; ++color) {
+            List<Colored> before, after;
+            std::copy_if(values.begin(), values.end(), std::back_inserter(before),
+                         [&](const Colored &v) { return v.color == color; });
+            std::copy_if(merged.begin(), merged.end(), std::back_inserter(after),
+                         [&](const Colored &v) { return v.color == color; });
+            ASSERT_EQ(area(before), area(after));
+        }
+        for (U64 i = 0; i < merged.size(); ++i) {
+            for (U64 j = i + 1; j < merged.size(); ++j) {
+                ASSERT_FALSE(merged[i].box.overlaps(merged[j].box));
+            }
+        }
+    }
+}
+
+} // namespace
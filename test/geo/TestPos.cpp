@@ -4,12 +4,21 @@
 #include "nvl/data/Map.h"
 #include "nvl/data/Maybe.h"
 #include "nvl/geo/Tuple.h"
+#include "nvl/geo/Volume.h"
+#include "nvl/math/Random.h"
+#include "nvl/time/Clock.h"
+#include "nvl/time/Duration.h"
 
 namespace {
 
+using nvl::Box;
+using nvl::List;
 using nvl::Map;
 using nvl::None;
 using nvl::Pos;
+using nvl::Tuple;
+using nvl::Vec;
+using nvl::Volume;
 
 using testing::ElementsAre;
 
@@ -233,4 +242,91 @@ TEST(TestPos, hash) {
     EXPECT_EQ(hash(a), hash(c));
 }
 
-} // namespace
\ No newline at end of file
+// Pos<2>, Pos<3>, and Vec<3> are padded to four lanes when targeting AVX2. Padding must not leak into any result.
+TEST(TestPos, padded) {
+    static_assert(Pos<3>::kPadded == nvl::detail::kPadTuples && Vec<3>::kPadded == nvl::detail::kPadTuples);
+    static_assert(!Pos<5>::kPadded && !Tuple<3, U64>::kPadded);
+#ifdef __AVX2__ // e.g. when configured with -DNVL_AVX2=ON
+    static_assert(Pos<2>::kPadded && sizeof(Pos<3>) == 4 * sizeof(I64) && sizeof(Box<3>) == 8 * sizeof(I64));
+#else
+    static_assert(!Pos<2>::kPadded && sizeof(Pos<3>) == 3 * sizeof(I64));
+#endif
+
+    constexpr Pos<3> a{1, 2, 3};
+    constexpr Pos<3> b{2, 3, 4};
+    EXPECT_TRUE(a.all_lt(b));
+    EXPECT_FALSE(b.all_lt(a));
+    EXPECT_FALSE(a.all_lt(a));
+    EXPECT_TRUE(a.all_lte(a));
+    EXPECT_FALSE(a.all_lt({2, 3, 3}));
+    EXPECT_TRUE(a.all_lte({1, 2, 3}));
+    EXPECT_FALSE(a.all_lte({1, 2, 2}));
+
+    // Scalar operations must leave the padding zero for later comparisons and hashes
+    EXPECT_EQ((a + 5) - 5, a);
+    EXPECT_EQ((a * -2) / -2, a);
+    EXPECT_EQ(std::hash<Pos<3>>()((a + 5) - 5), std::hash<Pos<3>>()(a));
+    EXPECT_EQ(a.product(), 6);
+    EXPECT_EQ(a.min(), 1);
+    EXPECT_EQ((-a).max(), -1);
+    EXPECT_EQ(-a, Pos<3>(-1, -2, -3));
+
+    constexpr Vec<3> v{-1.5, 0.5, 2};
+    EXPECT_EQ((v * -1.0) * -1.0, v);
+    EXPECT_EQ(std::hash<Vec<3>>()((v * -1.0) * -1.0), std::hash<Vec<3>>()(v));
+    EXPECT_TRUE(v.all_lt({-1, 1, 3}));
+
+    const Box<3> box({0, 0, 0}, {10, 10, 10});
+    EXPECT_TRUE(box.overlaps(Box<3>({9, 9, 9}, {11, 11, 11})));
+    EXPECT_FALSE(box.overlaps(Box<3>({10, 0, 0}, {11, 11, 11})));
+    EXPECT_TRUE(box.contains(Pos<3>(0, 9, 5)));
+    EXPECT_FALSE(box.contains(Pos<3>(0, 10, 5)));
+    EXPECT_TRUE(Box<2>({0, 0}, {1, 1}).contains(Pos<2>(0, 0)));
+}
+
+/// Runs a mix of element-wise operations and comparisons over [boxes], as in a typical hot loop over boxes.
+template <typename T>
+U64 padded_benchmark(const List<Volume<3, T>> &boxes) {
+    U64 count = 0;
+    for (U64 i = 1; i < boxes.size(); ++i) {
+        const Volume<3, T> &a = boxes[i - 1];
+        const Volume<3, T> &b = boxes[i];
+        count += a.overlaps(b) ? 1 : 0;
+        count += a.contains(b.min) ? 1 : 0;
+        count += (nvl::max(a.min, b.min) + a.min).all_lte(nvl::min(a.end, b.end) + b.min) ? 1 : 0;
+        count += a.min == b.min ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+List<Volume<3, T>> padded_benchmark_boxes() {
+    nvl::Random random(0xB0C5);
+    List<Volume<3, T>> boxes;
+    for (U64 i = 0; i < 1'000'000; ++i) {
+        const Pos<3> min = random.uniform<Pos<3>, I64>(0, 100);
+        const Pos<3> end = min + random.uniform<Pos<3>, I64>(1, 20);
+        boxes.emplace_back(Tuple<3, T>(min[0], min[1], min[2]), Tuple<3, T>(end[0], end[1], end[2]));
+    }
+    return boxes;
+}
+
+// Compares Box<3> against the generic, unpadded Volume<3, U64> on the same workload. Box<3> is only padded when
+// building with AVX2 (-DNVL_AVX2=ON); otherwise both take the generic path.
+// Current best is ~13ms (padded) vs. ~15ms (generic) for 1M boxes.
+TEST(TestPos, padded_benchmark) {
+    const List<Box<3>> padded_boxes = padded_benchmark_boxes<I64>();
+    const List<Volume<3, U64>> generic_boxes = padded_benchmark_boxes<U64>();
+
+    const auto padded_start = nvl::Clock::now();
+    const U64 padded = padded_benchmark(padded_boxes);
+    const auto padded_end = nvl::Clock::now();
+    const U64 generic = padded_benchmark(generic_boxes);
+    const auto generic_end = nvl::Clock::now();
+
+    std::cout << "Padded:  " << nvl::Duration(padded_end - padded_start) << std::endl;
+    std::cout << "Generic: " << nvl::Duration(generic_end - padded_end) << std::endl;
+    EXPECT_EQ(padded, generic);
+}
+
+} // namespace
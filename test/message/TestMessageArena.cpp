@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+#include "nvl/message/Hit.h"
+#include "nvl/message/MessageArena.h"
+#include "nvl/message/Notify.h"
+
+namespace {
+
+using nvl::AbstractMessage;
+using nvl::Box;
+using nvl::Hit;
+using nvl::Message;
+using nvl::MessageArena;
+using nvl::Notify;
+
+struct Counted final : AbstractMessage {
+    class_tag(Counted, AbstractMessage);
+    explicit Counted(I64 *count) : AbstractMessage(nullptr), count(count) { ++*count; }
+    ~Counted() override { --*count; }
+    pure std::string to_string() const override { return "Counted"; }
+    I64 *count;
+};
+
+TEST(TestMessageArena, emplace) {
+    MessageArena arena;
+    const Message hit = arena.emplace<Hit<2>>(nullptr, Box<2>({0, 0}, {2, 2}), 3);
+    const Message notify = arena.emplace<Notify>(nullptr, Notify::kMoved);
+    EXPECT_EQ(arena.size(), 2);
+    ASSERT_TRUE(hit.isa<Hit<2>>());
+    EXPECT_EQ(hit.dyn_cast<Hit<2>>()->strength, 3);
+    EXPECT_EQ(notify.dyn_cast<Hit<2>>(), nullptr);
+    EXPECT_EQ(notify.dyn_cast<Notify>()->cause, Notify::kMoved);
+}
+
+TEST(TestMessageArena, clear) {
+    MessageArena arena;
+    I64 count = 0;
+    for (I64 i = 0; i < 10'000; ++i) {
+        arena.emplace<Counted>(&count);
+    }
+    EXPECT_EQ(count, 10'000);
+    const U64 capacity = arena.capacity();
+    EXPECT_GT(capacity, MessageArena::kBlockSize);
+
+    arena.clear();
+    EXPECT_EQ(count, 0);
+    EXPECT_EQ(arena.size(), 0);
+
+    // Blocks are reused after clearing
+    for (I64 i = 0; i < 10'000; ++i) {
+        arena.emplace<Counted>(&count);
+    }
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+} // namespace
@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "nvl/reflect/Casting.h"
 #include "nvl/reflect/ClassTag.h"
+#include "nvl/time/Clock.h"
+#include "nvl/time/Duration.h"
 
 namespace {
 
@@ -118,4 +122,113 @@ TEST(TestClassTag, templated_types) {
     EXPECT_EQ(bar->value, 32);
 }
 
-} // namespace
\ No newline at end of file
+struct D : A, B {
+    class_tag(D, A, B);
+};
+struct E final : D {
+    class_tag(E, D);
+};
+
+TEST(TestClassTag, inherited_multiple_inheritance) {
+    // B is only reachable through the second parent of D
+    EXPECT_TRUE(ClassTag::get<E>() <= ClassTag::get<D>());
+    EXPECT_TRUE(ClassTag::get<E>() <= ClassTag::get<A>());
+    EXPECT_TRUE(ClassTag::get<E>() <= ClassTag::get<B>());
+    EXPECT_TRUE(ClassTag::get<E>() < ClassTag::get<B>());
+    EXPECT_FALSE(ClassTag::get<E>() <= ClassTag::get<C>());
+    EXPECT_FALSE(ClassTag::get<B>() <= ClassTag::get<E>());
+}
+
+struct L0 {
+    class_tag(L0);
+    virtual ~L0() = default;
+};
+struct L1 : L0 {
+    class_tag(L1, L0);
+};
+struct L2 : L1 {
+    class_tag(L2, L1);
+};
+struct L3 : L2 {
+    class_tag(L3, L2);
+};
+struct L4 : L3 {
+    class_tag(L4, L3);
+};
+struct L5 : L4 {
+    class_tag(L5, L4);
+};
+struct L6 : L5 {
+    class_tag(L6, L5);
+};
+struct L7 final : L6 {
+    class_tag(L7, L6);
+};
+struct M4 final : L3 {
+    class_tag(M4, L3);
+};
+
+TEST(TestClassTag, deep_hierarchy) {
+    EXPECT_EQ(ClassTag::get<L7>().depth, 7);
+    EXPECT_TRUE(ClassTag::get<L7>() <= ClassTag::get<L0>());
+    EXPECT_TRUE(ClassTag::get<L7>() < ClassTag::get<L4>());
+    EXPECT_TRUE(ClassTag::get<M4>() <= ClassTag::get<L3>());
+    EXPECT_FALSE(ClassTag::get<M4>() <= ClassTag::get<L4>());
+    EXPECT_FALSE(ClassTag::get<L4>() <= ClassTag::get<M4>());
+    EXPECT_FALSE(ClassTag::get<L4>() <= ClassTag::get<L7>());
+    EXPECT_TRUE(ClassTag::get<L0>() > ClassTag::get<L7>());
+}
+
+template <U64 I>
+struct Deep : Deep<I - 1> {
+    class_tag(Deep<I>, Deep<I - 1>);
+};
+template <>
+struct Deep<0> {
+    class_tag(Deep<0>);
+    virtual ~Deep() = default;
+};
+
+TEST(TestClassTag, deeper_than_display) {
+    // Ancestors past kMaxDepth don't fit in the display, and are found by walking the parents instead
+    constexpr U64 kDepth = ClassTag::kMaxDepth + 4;
+    EXPECT_EQ(ClassTag::get<Deep<kDepth>>().depth, kDepth);
+    EXPECT_FALSE(ClassTag::get<Deep<ClassTag::kMaxDepth>>().multiple);
+    EXPECT_TRUE(ClassTag::get<Deep<ClassTag::kMaxDepth + 1>>().multiple);
+    EXPECT_TRUE(ClassTag::get<Deep<kDepth>>() <= ClassTag::get<Deep<0>>());
+    EXPECT_TRUE(ClassTag::get<Deep<kDepth>>() <= ClassTag::get<Deep<ClassTag::kMaxDepth - 1>>());
+    EXPECT_TRUE(ClassTag::get<Deep<kDepth>>() <= ClassTag::get<Deep<ClassTag::kMaxDepth + 2>>());
+    EXPECT_TRUE(ClassTag::get<Deep<kDepth>>() < ClassTag::get<Deep<kDepth - 1>>());
+    EXPECT_FALSE(ClassTag::get<Deep<ClassTag::kMaxDepth + 2>>() <= ClassTag::get<Deep<kDepth>>());
+    EXPECT_FALSE(ClassTag::get<Deep<kDepth>>() <= ClassTag::get<L0>());
+
+    const std::unique_ptr<Deep<0>> instance = std::make_unique<Deep<kDepth>>();
+    EXPECT_NE(nvl::dyn_cast<Deep<ClassTag::kMaxDepth + 1>>(instance.get()), nullptr);
+    EXPECT_EQ(nvl::dyn_cast<Deep<kDepth + 1>>(instance.get()), nullptr);
+}
+
+// Measures dyn_cast throughput on instances from across a deep hierarchy.
+// Current best is ~3ns / cast
+TEST(TestClassTag, profile_casting) {
+    constexpr I64 kNumCasts = 10'000'000;
+    std::vector<std::unique_ptr<L0>> instances;
+    instances.push_back(std::make_unique<L0>());
+    instances.push_back(std::make_unique<L2>());
+    instances.push_back(std::make_unique<L4>());
+    instances.push_back(std::make_unique<L5>());
+    instances.push_back(std::make_unique<L7>());
+    instances.push_back(std::make_unique<M4>());
+    instances.push_back(std::make_unique<L3>());
+    instances.push_back(std::make_unique<L6>());
+
+    const auto start = nvl::Clock::now();
+    I64 count = 0;
+    for (I64 i = 0; i < kNumCasts; ++i) {
+        count += nvl::dyn_cast<L4>(instances[i % instances.size()].get()) != nullptr;
+    }
+    const auto end = nvl::Clock::now();
+    std::cout << "Time: " << nvl::Duration(end - start) / kNumCasts << " / cast" << std::endl;
+    EXPECT_EQ(count, kNumCasts / 2);
+}
+
+} // namespace
@@ -2,6 +2,7 @@
 #include <nvl/material/TestMaterial.h>
 
 #include "nvl/entity/Block.h"
+#include "nvl/material/Bulwark.h"
 #include "nvl/test/Fuzzing.h"
 #include "nvl/test/TensorWindow.h"
 #include "nvl/world/World.h"
@@ -52,6 +53,51 @@ TEST(TestWindow, draw) {
     EXPECT_TRUE(nvl::compare_tensors(std::cout, window.tensor(), expected));
 }
 
+/// Window which records the cubes drawn, using the default batched drawing methods.
+class CubeCountingWindow final : public nvl::Window {
+public:
+    CubeCountingWindow() : Window("counting", {160, 90}) {}
+    nvl::List<nvl::InputEvent> detect_events() override { return {}; }
+    void line_box(const Color &, const Box<2> &) override {}
+    void fill_box(const Color &, const Box<2> &) override {}
+    void line_cube(const Color &, const Box<3> &) override { ++lines; }
+    void fill_cube(const Color &, const Box<3> &cube) override { filled.push_back(cube); }
+    void line(const Color &, const nvl::Line<2> &) override {}
+    void line(const Color &, const nvl::Line<3> &) override {}
+    void text(const Color &, const Pos<2> &, I64, std::string_view) override {}
+    void centered_text(const Color &, const Pos<2> &, I64, std::string_view) override {}
+    void set_view_offset(const ViewOffset &) override {}
+    void end_view_offset(const ViewOffset &) override {}
+    pure bool should_close() const override { return false; }
+    pure I64 height() const override { return 90; }
+    pure I64 width() const override { return 160; }
+    pure I64 fps() const override { return 0; }
+
+    nvl::List<Box<3>> filled;
+    U64 lines = 0;
+};
+
+TEST(TestWindow, draw3d_visible) {
+    CubeCountingWindow window;
+    auto *world = window.open<World<3>>();
+    world->set_hud(false);
+    world->set_view(ViewOffset::at<3>(Pos<3>::zero)); // Looking along +X
+
+    auto bulwark = Material::get<nvl::Bulwark>();
+    world->spawn<Block<3>>(Pos<3>(100, -5, -5), Pos<3>(10, 10, 10), bulwark);  // In front of the camera
+    world->spawn<Block<3>>(Pos<3>(-100, -5, -5), Pos<3>(10, 10, 10), bulwark); // Behind the camera
+    world->spawn<Block<3>>(Pos<3>(100, -5, 500), Pos<3>(10, 10, 10), bulwark); // Off to the side
+    window.draw();
+
+    // Only the faces of the block in front of the camera are drawn
+    const Box<3> visible({100, -5, -5}, {110, 5, 5});
+    EXPECT_EQ(window.filled.size(), 6);
+    for (const Box<3> &face : window.filled) {
+        EXPECT_EQ(nvl::bounding_box(visible, face), visible) << face;
+    }
+    EXPECT_EQ(window.lines, 6);
+}
+
 struct FuzzDraw : nvl::test::FuzzingTestFixture<Tensor<2, Color>, Pos<2>, Pos<2>, Box<2>> {
     FuzzDraw() = default;
 };
@@ -130,6 +130,25 @@ TEST(TestWorld, first_3d) {
     EXPECT_EQ(intersect->pt, Vec<3>(528, 973.5, 500));
 }
 
+TEST(TestWorld, query_after_hit) {
+    NullWindow window;
+    World<2>::Params params;
+    params.gravity_accel = 0;
+    World<2> world(&window, params);
+    const auto material = Material::get<TestMaterial>(Color::kBlack);
+    const Actor block = world.spawn<Block<2>>(Pos<2>::zero, Pos<2>(100, 10), material)->self();
+    world.tick();
+    world.send<nvl::Hit<2>>(nullptr, block, Box<2>({50, 0}, {100, 10}), 1);
+    world.tick();
+    ASSERT_TRUE(world.has(block));
+    EXPECT_EQ(block.dyn_cast<Block<2>>()->bbox(), Box<2>({0, 0}, {50, 10}));
+
+    // The region cleared by the hit no longer contains the block
+    EXPECT_TRUE(world.entities(Box<2>({60, 0}, {70, 10})).empty());
+    EXPECT_FALSE(world.first_in(Pos<2>(65, 5)).has_value());
+    EXPECT_TRUE(world.first_in(Pos<2>(25, 5)).has_value());
+}
+
 TEST(TestWorld, stop_when_fallen) {
     TensorWindow window("stop_when_fallen", {10, 10});
     World<2>::Params params;
@@ -161,12 +180,13 @@ TEST(TestWorld, break_block) {
     material->falls = false;
     NullWindow window;
     auto *world = window.open<World<2>>();
+    nvl::MessageArena arena;
     auto &block = *world->spawn<Block<2>>(Pos<2>::zero, Box<2>{{817, 846}, {1135, 1106}}, material);
-    block.tick({Message::get<Hit<2>>(nullptr, Box<2>{{1100, 1005}, {1141, 1046}}, 1)});
+    block.tick(List<Message>{arena.emplace<Hit<2>>(nullptr, Box<2>{{1100, 1005}, {1141, 1046}}, 1)});
     EXPECT_EQ(world->num_alive(), 1);
-    block.tick({Message::get<Hit<2>>(nullptr, Box<2>{{1063, 1005}, {1104, 1046}}, 1)});
+    block.tick(List<Message>{arena.emplace<Hit<2>>(nullptr, Box<2>{{1063, 1005}, {1104, 1046}}, 1)});
     EXPECT_EQ(world->num_alive(), 1);
-    block.tick({Message::get<Hit<2>>(nullptr, Box<2>{{1024, 1005}, {1065, 1046}}, 1)});
+    block.tick(List<Message>{arena.emplace<Hit<2>>(nullptr, Box<2>{{1024, 1005}, {1065, 1046}}, 1)});
     EXPECT_EQ(world->num_alive(), 1);
 
     nvl::Set<Box<2>> boxes;
@@ -178,7 +198,7 @@ TEST(TestWorld, break_block) {
                                             Box<2>{{1063, 846}, {1100, 1005}}, Box<2>{{1100, 1046}, {1135, 1106}},
                                             Box<2>{{1100, 846}, {1135, 1005}}));
 
-    block.tick({Message::get<Hit<2>>(nullptr, Box<2>{{987, 1006}, {1028, 1047}}, 1)});
+    block.tick(List<Message>{arena.emplace<Hit<2>>(nullptr, Box<2>{{987, 1006}, {1028, 1047}}, 1)});
     boxes.clear();
     for (auto actor : world->entities()) {
         auto *blk = actor.dyn_cast<Block<2>>();
@@ -210,11 +230,175 @@ TEST(TestWorld, break_block2) {
         Part<2>({{1063, 1046}, {1100, 1106}}, material), Part<2>({{1100, 846}, {1135, 1005}}, material),
         Part<2>({{1100, 1046}, {1135, 1106}}, material),
     };
+    nvl::MessageArena arena;
     auto &block = *world->spawn<Block<2>>(Pos<2>::zero, parts.range());
-    block.tick({Message::get<Hit<2>>(nullptr, Box<2>{{987, 1006}, {1028, 1047}}, 1)});
+    block.tick(List<Message>{arena.emplace<Hit<2>>(nullptr, Box<2>{{987, 1006}, {1028, 1047}}, 1)});
     EXPECT_EQ(world->num_alive(), 1);
 }
 
+TEST(TestWorld, parallel_tick) {
+    auto bulwark = Material::get<Bulwark>();
+    auto material = Material::get<TestMaterial>(Color::kBlack);
+    auto settle = [&](const I64 threads) {
+        NullWindow window;
+        World<2> world(&window, {.tick_threads = threads});
+        world.spawn<Block<2>>(Pos<2>(0, 500), Pos<2>(1000, 10), bulwark);
+        std::vector<const Block<2> *> blocks;
+        for (I64 x = 0; x < 1000; x += 25) {
+            for (I64 y = 0; y < 400; y += 40) {
+                // Stagger the columns so that blocks start moving at different times
+                blocks.push_back(world.spawn<Block<2>>(Pos<2>(x + y % 7, y + x % 13), Pos<2>(20, 30), material));
+            }
+        }
+        for (U64 i = 0; i < 500 && world.num_awake() > 0; ++i) {
+            world.tick();
+        }
+        EXPECT_EQ(world.num_awake(), 0);
+        std::vector<Box<2>> boxes;
+        for (const Block<2> *block : blocks) {
+            boxes.push_back(block->bbox());
+        }
+        return boxes;
+    };
+    const std::vector<Box<2>> boxes = settle(4);
+    EXPECT_EQ(boxes, settle(2));
+    EXPECT_EQ(boxes, settle(7));
+
+    for (U64 i = 0; i < boxes.size(); ++i) {
+        EXPECT_LE(boxes[i].end[1], 500);
+        for (U64 j = i + 1; j < boxes.size(); ++j) {
+            EXPECT_FALSE(boxes[i].intersect(boxes[j]).has_value()) << boxes[i] << " overlaps " << boxes[j];
+        }
+    }
+}
+
+/// Block with a constant acceleration, e.g. to push it sideways.
+struct Pusher final : Block<2> {
+    class_tag(Pusher, Block<2>);
+    Pusher(const Pos<2> &loc, const Pos<2> &shape, const Material &material, const Pos<2> &accel)
+        : Block(loc, shape, material) {
+        this->accel_ = accel;
+    }
+};
+
+TEST(TestWorld, parallel_tick_head_on) {
+    auto material = Material::get<TestMaterial>(Color::kBlack);
+    World<2>::Params params;
+    params.gravity_accel = 0;
+    params.tick_threads = 2;
+    NullWindow window;
+    World<2> world(&window, params);
+    // Both blocks plan to move into the same gap in the same tick
+    const auto *left = world.spawn<Pusher>(Pos<2>(0, 0), Pos<2>(10, 10), material, Pos<2>(7, 0));
+    const auto *right = world.spawn<Pusher>(Pos<2>(100, 0), Pos<2>(10, 10), material, Pos<2>(-7, 0));
+    for (U64 i = 0; i < 10; ++i) {
+        world.tick();
+        EXPECT_FALSE(left->bbox().overlaps(right->bbox())) << left->bbox() << " overlaps " << right->bbox();
+    }
+    EXPECT_EQ(left->bbox().end[0], right->bbox().min[0]);
+}
+
+TEST(TestWorld, islands) {
+    NullWindow window;
+    World<2> world(&window);
+    auto bulwark = Material::get<Bulwark>();
+    auto material = Material::get<TestMaterial>(Color::kBlack);
+    const Actor ground = world.spawn<Block<2>>(Pos<2>(0, 100), Pos<2>(100, 10), bulwark)->self();
+    // Two separate stacks resting on the same ground
+    std::vector<Actor> stack_a, stack_b;
+    for (I64 i = 0; i < 4; ++i) {
+        stack_a.push_back(world.spawn<Block<2>>(Pos<2>(0, 90 - 10 * i), Pos<2>(10, 10), material)->self());
+        stack_b.push_back(world.spawn<Block<2>>(Pos<2>(50, 90 - 10 * i), Pos<2>(10, 10), material)->self());
+    }
+    world.tick();
+    EXPECT_EQ(world.num_awake(), 0);
+
+    const nvl::List<nvl::Set<Actor>> grounded = world.islands(nvl::List<Actor>{ground}.range());
+    ASSERT_EQ(grounded.size(), 1);
+    EXPECT_EQ(grounded[0].size(), 9);
+
+    const nvl::List<nvl::Set<Actor>> islands = world.islands(nvl::List<Actor>{stack_a[1], stack_b[0]}.range());
+    ASSERT_EQ(islands.size(), 2);
+    const nvl::Set<Actor> &island_a = islands[0].has(stack_a[1]) ? islands[0] : islands[1];
+    const nvl::Set<Actor> &island_b = islands[0].has(stack_a[1]) ? islands[1] : islands[0];
+    EXPECT_THAT(island_a, UnorderedElementsAre(stack_a[1], stack_a[2], stack_a[3]));
+    EXPECT_THAT(island_b, UnorderedElementsAre(stack_b[0], stack_b[1], stack_b[2], stack_b[3]));
+
+    // Removing the ground wakes each stack as a unit once its bottom block starts falling
+    world.send<nvl::Destroy>(nullptr, ground, nvl::Destroy::kRemoved);
+    world.tick(); // Ground is destroyed, notifying the bottom blocks
+    world.tick(); // Bottom blocks start falling, waking everything above them
+    EXPECT_EQ(world.num_awake(), 8);
+}
+
+TEST(TestWorld, broadcast) {
+    NullWindow window;
+    World<2> world(&window);
+    auto bulwark = Material::get<Bulwark>();
+    const Actor a = world.spawn<Block<2>>(Pos<2>(0, 0), Pos<2>(10, 10), bulwark)->self();
+    const Actor b = world.spawn<Block<2>>(Pos<2>(20, 0), Pos<2>(10, 10), bulwark)->self();
+    const Actor c = world.spawn<Block<2>>(Pos<2>(40, 0), Pos<2>(10, 10), bulwark)->self();
+    world.tick();
+
+    // Duplicate recipients only receive the message once
+    const nvl::List<Actor> recipients{a, b, a, c, b};
+    EXPECT_EQ(world.send<nvl::Notify>(nullptr, recipients.range(), nvl::Notify::kMoved), 3);
+    EXPECT_EQ(world.num_messages(a), 1);
+    EXPECT_EQ(world.num_messages(b), 1);
+    EXPECT_EQ(world.num_messages(c), 1);
+    EXPECT_EQ(world.fanout_last(), 3);
+    EXPECT_EQ(world.fanout_max(), 3);
+    world.tick();
+    EXPECT_EQ(world.messages_last(), 3);
+    EXPECT_EQ(world.fanout_last(), 0);
+    EXPECT_EQ(world.fanout_max(), 3);
+
+    // Messages to actors which no longer exist are dropped on delivery
+    world.remove(c);
+    world.tick();
+    EXPECT_EQ(world.send<nvl::Notify>(nullptr, nvl::List<Actor>{a, c}.range(), nvl::Notify::kMoved), 2);
+    world.tick();
+    EXPECT_EQ(world.messages_last(), 1);
+    EXPECT_EQ(world.num_messages(c), 0);
+}
+
+/// Block which can be changed without notifying its neighbors.
+struct Ledge final : Block<2> {
+    class_tag(Ledge, Block<2>);
+    Ledge(const Pos<2> &loc, const Pos<2> &shape, const Material &material) : Block(loc, shape, material) {}
+    void shift(const Pos<2> &delta) { this->parts_.loc += delta; }
+    void carve() { this->parts_.clear(); }
+};
+
+TEST(TestWorld, resting_contact_cache) {
+    NullWindow window;
+    World<2> world(&window);
+    auto bulwark = Material::get<Bulwark>();
+    auto material = Material::get<TestMaterial>(Color::kBlack);
+    auto *ground = world.spawn<Ledge>(Pos<2>(0, 100), Pos<2>(100, 10), bulwark);
+    const Actor support = ground->self();
+    const auto *block = world.spawn<Block<2>>(Pos<2>(0, 90), Pos<2>(10, 10), material);
+    world.tick();
+    EXPECT_EQ(world.num_awake(), 0);
+    EXPECT_TRUE(block->has_below());
+
+    // Moving the support invalidates the cached support
+    ground->shift(Pos<2>(0, 1));
+    EXPECT_FALSE(block->has_below());
+    ground->shift(Pos<2>(0, -1));
+    EXPECT_TRUE(block->has_below());
+
+    // While neither entity moves, the cached support is reused without checking the support's parts
+    ground->carve();
+    EXPECT_TRUE(block->has_below());
+
+    // Removing the support without notifying the block invalidates the cached support
+    world.remove(support);
+    world.tick();
+    EXPECT_FALSE(world.has(support));
+    EXPECT_FALSE(block->has_below());
+}
+
 struct FuzzFall : nvl::test::FuzzingTestFixture<Box<2>, Pos<2>, Pos<2>, I64, I64> {
     FuzzFall() = default;
 };